@@ -0,0 +1,504 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/cube.h"
+#include "../src/coord.h"
+#include "../src/solve.h"
+#include "../src/steps.h"
+#include "../src/nissy.h"
+
+/*
+ * Benchmarks for nissy. Each result is printed as a JSON object on its
+ * own line, so that the output of two runs can be compared. The first one
+ * names the version of the cube operations that was compiled in, which
+ * depends on the SIMD flags.
+ *
+ * The coordinate indexers are always measured: the average cost of a
+ * call to index() and to to_cube() for each Indexer, on a set of
+ * random-state cubes.
+ *
+ * If a tables file is given, it also measures:
+ * - the time taken by init_cube() and by nissy_init();
+ * - for each step whose tables are in the file, the raw number of nodes
+ *   expanded per second, as in the DFS but without any pruning, and the
+ *   p50 and p99 latency of solving each scramble of a fixed corpus at
+ *   each depth in depths[], for each SolutionType; if nissy is compiled
+ *   with STATS defined, also the number of nodes searched per second;
+ * - the move tables of the coordinates in the file, in both layouts:
+ *   sweeping all the indexes in order as the BFS of the pruning tables
+ *   does, and expanding all the children of the nodes of a random walk
+ *   as the DFS does.
+ * Everything is seeded, so every run uses the same cubes and scrambles.
+ */
+
+#define NCUBES     4096
+#define ROUNDS     256
+#define WALKS      (1<<20)
+#define NSCRAMBLES 128
+#define SCRAMBLE_LEN 20
+
+/* Same conditions as in cube.c */
+#if defined(__AVX2__)
+#define KERNEL "avx2"
+#elif defined(__SSSE3__)
+#define KERNEL "ssse3"
+#else
+#define KERNEL "scalar"
+#endif
+
+extern Indexer i_eofb;
+extern Indexer i_coud;
+extern Indexer i_cp;
+extern Indexer i_epos;
+extern Indexer i_epe;
+extern Indexer i_eposepe;
+extern Indexer i_epud;
+
+typedef struct {
+	char *name;
+	Indexer *i;
+} NamedIndexer;
+
+static double elapsed_ns(struct timespec *, struct timespec *);
+static uint32_t lcg(uint32_t *);
+static int cmp_double(const void *, const void *);
+static void bench_indexer(NamedIndexer *);
+static void gen_cubes(void);
+static void gen_scrambles(void);
+static char *read_file(char *, size_t *);
+static void bench_init(char *, size_t);
+static bool step_generated(Step *);
+static double bench_nodes(Step *);
+static void bench_solve(Step *, char *, int);
+static void count_sol(char *, void *);
+static void set_layout(Coordinate *, bool);
+static double bench_bfs(Coordinate *);
+static double bench_dfs(Coordinate *);
+static void bench_mtable(Coordinate *);
+
+static NamedIndexer indexers[] = {
+	{ "eofb",    &i_eofb    },
+	{ "coud",    &i_coud    },
+	{ "cp",      &i_cp      },
+	{ "epos",    &i_epos    },
+	{ "epe",     &i_epe     },
+	{ "eposepe", &i_eposepe },
+	{ "epud",    &i_epud    },
+	{ NULL,      NULL       },
+};
+
+static char *types[] = { "normal", "inverse", "niss", NULL };
+static int depths[] = { 3, 4, 5, -1 };
+
+static Cube cubes[NCUBES];
+static char scrambles[NSCRAMBLES][4*SCRAMBLE_LEN];
+
+/* Written to, so that the compiler cannot discard the calls */
+volatile coord_value_t sink;
+
+static double
+elapsed_ns(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1e9 +
+	    (end->tv_nsec - start->tv_nsec);
+}
+
+/* Deterministic on every platform, unlike rand() */
+static uint32_t
+lcg(uint32_t *r)
+{
+	*r = *r * 1103515245 + 12345;
+
+	return *r >> 16;
+}
+
+static int
+cmp_double(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void
+bench_indexer(NamedIndexer *ni)
+{
+	int i, r;
+	coord_value_t acc, ind[NCUBES];
+	double tindex, tcube;
+	struct timespec start, end;
+	Cube c;
+
+	acc = 0;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (r = 0; r < ROUNDS; r++)
+		for (i = 0; i < NCUBES; i++)
+			acc += ni->i->index(&cubes[i]);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	tindex = elapsed_ns(&start, &end) / ((double)ROUNDS * NCUBES);
+
+	for (i = 0; i < NCUBES; i++)
+		ind[i] = ni->i->index(&cubes[i]);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (r = 0; r < ROUNDS; r++) {
+		for (i = 0; i < NCUBES; i++) {
+			make_solved(&c);
+			ni->i->to_cube(ind[i], &c);
+			acc += c.edge[r & 15] + c.corner[i & 7];
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	tcube = elapsed_ns(&start, &end) / ((double)ROUNDS * NCUBES);
+
+	sink = acc;
+	printf("{\"bench\": \"indexer\", \"name\": \"%s\", "
+	    "\"size\": %" PRIu32 ", \"index_ns\": %.1f, "
+	    "\"to_cube_ns\": %.1f}\n",
+	    ni->name, (uint32_t)ni->i->n, tindex, tcube);
+}
+
+static void
+gen_cubes(void)
+{
+	int i, j;
+
+	srand(1);
+	for (i = 0; i < NCUBES; i++) {
+		make_solved(&cubes[i]);
+		for (j = 0; j < 40; j++)
+			apply_move((Move)(U + rand() % (NMOVES_HTM-1)), &cubes[i]);
+	}
+}
+
+/* Random moves, never two in a row on the same axis */
+static void
+gen_scrambles(void)
+{
+	int i, j;
+	uint32_t r;
+	Move m, last;
+	Alg alg;
+
+	r = 1;
+	for (i = 0; i < NSCRAMBLES; i++) {
+		alg.len = 0;
+		for (j = 0, last = NULLMOVE; j < SCRAMBLE_LEN; j++) {
+			do {
+				m = (Move)(U + lcg(&r) % (NMOVES_HTM-1));
+			} while (last != NULLMOVE &&
+			    (m - U) / 6 == (last - U) / 6);
+			append_move(&alg, m, false);
+			last = m;
+		}
+		alg_string(&alg, scrambles[i]);
+	}
+}
+
+static char *
+read_file(char *path, size_t *n)
+{
+	long size;
+	char *buf;
+	FILE *f;
+
+	if ((f = fopen(path, "rb")) == NULL)
+		return NULL;
+
+	buf = NULL;
+	if (fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) > 0 &&
+	    fseek(f, 0, SEEK_SET) == 0 && (buf = malloc(size)) != NULL &&
+	    fread(buf, 1, size, f) != (size_t)size) {
+		free(buf);
+		buf = NULL;
+	}
+	if (buf != NULL)
+		*n = size;
+	fclose(f);
+
+	return buf;
+}
+
+static void
+bench_init(char *buf, size_t size)
+{
+	struct timespec start, end;
+	double tcube, tinit;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	init_cube();
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	tcube = elapsed_ns(&start, &end);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if (nissy_init(buf, size) != 0) {
+		fprintf(stderr, "Error reading tables\n");
+		exit(1);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	tinit = elapsed_ns(&start, &end);
+
+	printf("{\"bench\": \"init\", \"name\": \"init_cube\", "
+	    "\"ms\": %.3f}\n", tcube / 1e6);
+	printf("{\"bench\": \"init\", \"name\": \"nissy_init\", "
+	    "\"ms\": %.3f}\n", tinit / 1e6);
+}
+
+static bool
+step_generated(Step *s)
+{
+	int i;
+
+	for (i = 0; s->coord[i] != NULL; i++)
+		if (!s->coord[i]->generated)
+			return false;
+
+	return true;
+}
+
+/* Nodes per second, walking randomly from the first scramble */
+static double
+bench_nodes(Step *s)
+{
+	int i, j, n;
+	long k, nodes;
+	uint32_t r;
+	Move m, mm;
+	Trans tt;
+	Cube c;
+	CubeState state[MAX_N_COORD], child[NMOVES_HTM][MAX_N_COORD];
+	Coordinate **coord;
+	struct timespec start, end;
+
+	coord = s->coord;
+	make_solved(&c);
+	apply_scramble(scrambles[0], &c);
+	for (i = 0; coord[i] != NULL; i++) {
+		state[i].val = index_coord(coord[i], &c, &state[i].t);
+		state[i].dist = ptabledist(coord[i], state[i].val);
+	}
+
+	r = 1;
+	nodes = 0;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (k = 0; k < WALKS; k++) {
+		for (m = U, n = 0; m <= B3; m++) {
+			if (!s->moveset(m))
+				continue;
+			for (i = 0; coord[i] != NULL; i++) {
+				mm = transform_move(state[i].t, m);
+				child[n][i].val = move_coord(coord[i], mm,
+				    state[i].val, &tt);
+				child[n][i].t = transform_trans(tt, state[i].t);
+				child[n][i].dist = ptableneighbor(coord[i],
+				    child[n][i].val, state[i].dist);
+			}
+			n++;
+		}
+		nodes += n;
+		j = lcg(&r) % n;
+		memcpy(state, child[j], sizeof(state));
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	sink = state[0].val;
+
+	return nodes / (elapsed_ns(&start, &end) / 1e9);
+}
+
+static void
+count_sol(char *sol, void *data)
+{
+	(*(long *)data)++;
+}
+
+/* All the solutions of length d of each scramble, on one thread */
+static void
+bench_solve(Step *s, char *type, int d)
+{
+	int i, j;
+	long nsols;
+	uint64_t nodes;
+	double t[NSCRAMBLES], total;
+	struct timespec start, end;
+	struct nissy_stats stats;
+
+	nsols = 0;
+	nodes = 0;
+	total = 0;
+	for (i = 0; i < NSCRAMBLES; i++) {
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		nissy_solve_stats(s->shortname, "uf", d, d, -1, type,
+		    scrambles[i], count_sol, &nsols, 1, 0, &stats);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		t[i] = elapsed_ns(&start, &end) / 1e3;
+		total += t[i];
+		for (j = 0; j <= d; j++)
+			nodes += stats.nodes[j];
+	}
+	qsort(t, NSCRAMBLES, sizeof(double), cmp_double);
+
+	printf("{\"bench\": \"solve\", \"step\": \"%s\", "
+	    "\"type\": \"%s\", \"depth\": %d, \"scrambles\": %d, "
+	    "\"solutions\": %ld, \"mean_us\": %.1f, \"p50_us\": %.1f, "
+	    "\"p99_us\": %.1f",
+	    s->shortname, type, d, NSCRAMBLES, nsols, total / NSCRAMBLES,
+	    t[(NSCRAMBLES-1)*50/100], t[(NSCRAMBLES-1)*99/100]);
+	if (nodes > 0)
+		printf(", \"nodes\": %" PRIu64 ", \"nodes_per_sec\": %.0f",
+		    nodes, nodes / (total / 1e6));
+	printf("}\n");
+}
+
+/* Copies the move tables of coord to the given layout, the old ones leak */
+static void
+set_layout(Coordinate *coord, bool indexmajor)
+{
+	Move m;
+	coord_value_t i, ii, oi;
+	Coordinate old;
+
+	old = *coord;
+	coord->indexmajor = indexmajor;
+	alloc_mtable(coord);
+	if (coord->type == SYM_COORD)
+		alloc_ttrep_move(coord);
+
+	for (m = 0; m < NMOVES_HTM; m++) {
+		for (i = 0; i < coord->max; i++) {
+			ii = i * coord->mstride;
+			oi = i * old.mstride;
+			tableset(coord, coord->mtable[m], ii,
+			    tableval(&old, old.mtable[m], oi));
+			if (coord->type == SYM_COORD)
+				coord->ttrep_move[m][ii] = old.ttrep_move[m][oi];
+		}
+	}
+}
+
+/* Nanoseconds per move */
+static double
+bench_bfs(Coordinate *coord)
+{
+	coord_value_t i, acc;
+	Move m;
+	long n;
+	struct timespec start, end;
+
+	acc = 0;
+	n = 0;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < coord->max; i++) {
+		for (m = U; m <= B3; m++) {
+			if (!coord->moveset(m))
+				continue;
+			acc += move_coord(coord, m, i, NULL);
+			n++;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	sink = acc;
+
+	return elapsed_ns(&start, &end) / n;
+}
+
+/* Nanoseconds per node */
+static double
+bench_dfs(Coordinate *coord)
+{
+	int j, n;
+	long k;
+	coord_value_t ind, child[NMOVES_HTM];
+	Move m;
+	Trans t;
+	uint32_t r;
+	struct timespec start, end;
+
+	ind = 0;
+	r = 1;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (k = 0; k < WALKS; k++) {
+		for (m = U, n = 0; m <= B3; m++)
+			if (coord->moveset(m))
+				child[n++] = move_coord(coord, m, ind, &t);
+		r = r * 1103515245 + 12345;
+		j = (r >> 16) % n;
+		ind = child[j];
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	sink = ind;
+
+	return elapsed_ns(&start, &end) / WALKS;
+}
+
+static void
+bench_mtable(Coordinate *coord)
+{
+	int i;
+	bool layout[2] = { false, true };
+	double bfs[2], dfs[2];
+
+	for (i = 0; i < 2; i++) {
+		set_layout(coord, layout[i]);
+		bfs[i] = bench_bfs(coord);
+		dfs[i] = bench_dfs(coord);
+	}
+
+	printf("{\"bench\": \"mtable\", \"name\": \"%s\", "
+	    "\"size\": %" PRIu32 ", \"bfs_move_ns\": %.2f, "
+	    "\"bfs_idx_ns\": %.2f, \"dfs_move_ns\": %.1f, "
+	    "\"dfs_idx_ns\": %.1f}\n",
+	    coord->name, coord->max, bfs[0], bfs[1], dfs[0], dfs[1]);
+}
+
+int
+main(int argc, char *argv[])
+{
+	int i, j, k;
+	size_t size;
+	char *buf;
+	NamedIndexer *ni;
+
+	printf("{\"bench\": \"kernel\", \"name\": \"%s\"}\n", KERNEL);
+
+	init_cube();
+	gen_cubes();
+	gen_scrambles();
+
+	for (ni = indexers; ni->name != NULL; ni++)
+		bench_indexer(ni);
+
+	if (argc < 2)
+		return 0;
+
+	if ((buf = read_file(argv[1], &size)) == NULL) {
+		fprintf(stderr, "Error reading tables\n");
+		return 1;
+	}
+	bench_init(buf, size);
+	free(buf);
+
+	for (i = 0; steps[i] != NULL; i++) {
+		if (!step_generated(steps[i]))
+			continue;
+		printf("{\"bench\": \"nodes\", \"step\": \"%s\", "
+		    "\"nodes_per_sec\": %.0f}\n",
+		    steps[i]->shortname, bench_nodes(steps[i]));
+		for (j = 0; types[j] != NULL; j++)
+			for (k = 0; depths[k] != -1; k++)
+				bench_solve(steps[i], types[j], depths[k]);
+	}
+
+	/* Last, because it changes the layout of the move tables */
+	for (i = 0; coordinates[i] != NULL; i++)
+		if (coordinates[i]->type != SYMCOMP_COORD &&
+		    coordinates[i]->generated)
+			bench_mtable(coordinates[i]);
+
+	return 0;
+}
@@ -1,8 +1,12 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <inttypes.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "../src/cube.h"
 #include "../src/coord.h"
@@ -10,76 +14,185 @@
 #include "../src/steps.h"
 #include "../src/nissy.h"
 
+#define MAX_THREADS 64
+
+/*
+ * The pruning table BFS switches from top-down to bottom-up when the
+ * frontier is larger than the unvisited part of the table divided by
+ * BOTTOMUP_ALPHA, and goes back to top-down when it is smaller than the
+ * unvisited part divided by BOTTOMUP_BETA. Near the end, when little is
+ * left unvisited, bottom-up is kept even if the frontier is small.
+ */
+#define BOTTOMUP_ALPHA 2
+#define BOTTOMUP_BETA  32
+
+typedef struct {
+	Coordinate *coord;
+	coord_value_t start;
+	coord_value_t end;
+	int d;
+	coord_value_t updated;
+} GenArg;
+
+static coord_value_t run_threads(
+    Coordinate *, coord_value_t, int, void *(*)(void *));
+static void *gen_coord_comp_mtable(void *);
+static void *gen_coord_comp_ttable(void *);
+static void *gen_coord_sym_mtable(void *);
 static void gen_coord_comp(Coordinate *);
 static void gen_coord_sym(Coordinate *);
 static void gen_ptable(Coordinate *);
-static void gen_ptable_bfs(Coordinate *, int);
-static void gen_ptable_fixnasty(Coordinate *, coord_value_t, int);
+static coord_value_t gen_ptable_bfs(Coordinate *, int, bool);
+static void *gen_ptable_bfs_worker(void *);
+static void *gen_ptable_bfs_bottomup_worker(void *);
+static coord_value_t gen_ptable_fixnasty(Coordinate *, coord_value_t, int);
+static int ptableval_atomic(Coordinate *, coord_value_t);
+static bool ptableupdate_atomic(Coordinate *, coord_value_t, int);
 static void gen_ptable_compress(Coordinate *);
 static void gen_ptable_setbase(Coordinate *);
 
-static char buf[TABLESFILESIZE];
+static double elapsed(struct timespec *);
+static size_t writefile(void *, void *, size_t);
 
-static void
-gen_coord_comp(Coordinate *coord)
+static int nthreads = 1;
+
+static coord_value_t
+run_threads(Coordinate *coord, coord_value_t n, int d, void *(*f)(void *))
 {
+	int i;
+	coord_value_t chunk, updated;
+	pthread_t thread[MAX_THREADS];
+	GenArg arg[MAX_THREADS];
+
+	/* Every index is independent, so we just split [0, n) evenly */
+	chunk = (n + nthreads - 1) / nthreads;
+	for (i = 0; i < nthreads; i++) {
+		arg[i].coord = coord;
+		arg[i].start = MIN(n, i * chunk);
+		arg[i].end = MIN(n, (i+1) * chunk);
+		arg[i].d = d;
+		arg[i].updated = 0;
+		if (pthread_create(&thread[i], NULL, f, &arg[i])) {
+			fprintf(stderr, "Error creating thread %d\n", i);
+			exit(1);
+		}
+	}
+
+	updated = 0;
+	for (i = 0; i < nthreads; i++) {
+		pthread_join(thread[i], NULL);
+		updated += arg[i].updated;
+	}
+
+	return updated;
+}
+
+static void *
+gen_coord_comp_mtable(void *a)
+{
+	GenArg *arg = a;
 	coord_value_t ui;
 	Cube c, mvd;
 	Move m;
+
+	for (ui = arg->start; ui < arg->end; ui++) {
+		indexers_makecube(arg->coord->i, ui, &c);
+		for (m = 0; m < NMOVES_HTM; m++) {
+			copy_cube(&c, &mvd);
+			apply_move(m, &mvd);
+			tableset(arg->coord, arg->coord->mtable[m],
+			    ui * arg->coord->mstride,
+			    indexers_getind(arg->coord->i, &mvd));
+		}
+	}
+
+	return NULL;
+}
+
+static void *
+gen_coord_comp_ttable(void *a)
+{
+	GenArg *arg = a;
+	coord_value_t ui;
+	Cube c, mvd;
 	Trans t;
 
+	for (ui = arg->start; ui < arg->end; ui++) {
+		indexers_makecube(arg->coord->i, ui, &c);
+		for (t = 0; t < NTRANS; t++) {
+			copy_cube(&c, &mvd);
+			apply_trans(t, &mvd);
+			tableset(arg->coord, arg->coord->ttable[t], ui,
+			    indexers_getind(arg->coord->i, &mvd));
+		}
+	}
+
+	return NULL;
+}
+
+static void *
+gen_coord_sym_mtable(void *a)
+{
+	GenArg *arg = a;
+	Coordinate *coord = arg->coord;
+	coord_value_t ui, uj, uu;
+	Move m;
+
+	for (ui = arg->start; ui < arg->end; ui++) {
+		uu = coord->symrep[ui];
+		for (m = 0; m < NMOVES_HTM; m++) {
+			uj = move_coord(coord->base[0], m, uu, NULL);
+			tableset(coord, coord->mtable[m], ui * coord->mstride,
+			    tableval(coord, coord->symclass, uj));
+			coord->ttrep_move[m][ui * coord->mstride] =
+			    coord->transtorep[uj];
+		}
+	}
+
+	return NULL;
+}
+
+static void
+gen_coord_comp(Coordinate *coord)
+{
 	fprintf(stderr, "%s: generating COMP coordinate\n", coord->name);
 
 	coord->max = indexers_getmax(coord->i);
+	set_width(coord);
 
 	fprintf(stderr, "%s: size is %" PRIu32 "\n", coord->name, coord->max);
 
 	fprintf(stderr, "%s: generating mtable\n", coord->name);
 	alloc_mtable(coord);
-	for (ui = 0; ui < coord->max; ui++) {
-		if (ui % 100000 == 0)
-			fprintf(stderr, "\t(%" PRIu32 " done)\n", ui);
-		indexers_makecube(coord->i, ui, &c);
-		for (m = 0; m < NMOVES_HTM; m++) {
-			copy_cube(&c, &mvd);
-			apply_move(m, &mvd);
-			coord->mtable[m][ui] = indexers_getind(coord->i, &mvd);
-		}
-	}
+	run_threads(coord, coord->max, 0, gen_coord_comp_mtable);
 	fprintf(stderr, "\t(%" PRIu32 " done)\n", coord->max);
 
 	fprintf(stderr, "%s: generating ttable\n", coord->name);
 	alloc_ttable(coord);
-	for (ui = 0; ui < coord->max; ui++) {
-		if (ui % 100000 == 0)
-			fprintf(stderr, "\t(%" PRIu32 " done)\n", ui);
-		indexers_makecube(coord->i, ui, &c);
-		for (t = 0; t < NTRANS; t++) {
-			copy_cube(&c, &mvd);
-			apply_trans(t, &mvd);
-			coord->ttable[t][ui] = indexers_getind(coord->i, &mvd);
-		}
-	}
+	run_threads(coord, coord->max, 0, gen_coord_comp_ttable);
 	fprintf(stderr, "\t(%" PRIu32 " done)\n", coord->max);
 }
 
 static void
 gen_coord_sym(Coordinate *coord)
 {
-	coord_value_t i, in, ui, uj, uu, nr;
+	coord_value_t i, in, nr, M;
 	int j;
-	Move m;
 	Trans t;
+	void *symclass;
 
 	fprintf(stderr, "%s: generating SYM coordinate\n", coord->name);
 
+	/* The number of classes is not known yet */
+	coord->width = 4;
 	alloc_sd(coord, true);
 
 	fprintf(stderr, "%s: generating symdata\n", coord->name);
-	for (i = 0; i < coord->base[0]->max; i++)
-		coord->symclass[i] = coord->base[0]->max + 1;
-	for (i = 0, nr = 0; i < coord->base[0]->max; i++) {
-		if (coord->symclass[i] != coord->base[0]->max + 1)
+	M = coord->base[0]->max;
+	for (i = 0; i < M; i++)
+		tableset(coord, coord->symclass, i, M + 1);
+	for (i = 0, nr = 0; i < M; i++) {
+		if (tableval(coord, coord->symclass, i) != M + 1)
 			continue;
 
 		coord->symrep[nr] = i;
@@ -88,7 +201,7 @@ gen_coord_sym(Coordinate *coord)
 		for (j = 0; j < coord->tgrp->n; j++) {
 			t = coord->tgrp->t[j];
 			in = trans_coord(coord->base[0], t, i);
-			coord->symclass[in] = nr;
+			tableset(coord, coord->symclass, in, nr);
 			if (in == i)
 				coord->selfsim[nr] |= ((coord_value_t)1<<t);
 			else
@@ -102,6 +215,16 @@ gen_coord_sym(Coordinate *coord)
 	fprintf(stderr, "%s: number of classes is %" PRIu32 "\n",
 	    coord->name, coord->max);
 
+	set_width(coord);
+	if (coord->width != 4) {
+		symclass = coord->symclass;
+		coord->symclass = malloc(M * coord->width);
+		for (i = 0; i < M; i++)
+			tableset(coord, coord->symclass, i,
+			    ((uint32_t *)symclass)[i]);
+		free(symclass);
+	}
+
 	/* Reallocating for maximum number of classes found */
 	/* TODO: remove, not needed anymore because not writing to file */
 	/*
@@ -112,16 +235,7 @@ gen_coord_sym(Coordinate *coord)
 	fprintf(stderr, "%s: generating mtable and ttrep_move\n", coord->name);
 	alloc_mtable(coord);
 	alloc_ttrep_move(coord);
-	for (ui = 0; ui < coord->max; ui++) {
-		if (ui % 100000 == 0)
-			fprintf(stderr, "\t(%" PRIu32 " done)\n", ui);
-		uu = coord->symrep[ui];
-		for (m = 0; m < NMOVES_HTM; m++) {
-			uj = move_coord(coord->base[0], m, uu, NULL);
-			coord->mtable[m][ui] = coord->symclass[uj];
-			coord->ttrep_move[m][ui] = coord->transtorep[uj];
-		}
-	}
+	run_threads(coord, coord->max, 0, gen_coord_sym_mtable);
 	fprintf(stderr, "\t(%" PRIu32 " done)\n", coord->max);
 }
 
@@ -174,12 +288,30 @@ error_gc:
 	exit(1);
 }
 
+static size_t
+writefile(void *file, void *buf, size_t n)
+{
+	return fwrite(buf, 1, n, file);
+}
+
+static double
+elapsed(struct timespec *start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return (end.tv_sec - start->tv_sec) +
+	    (end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
 static void
 gen_ptable(Coordinate *coord)
 {
-	bool compact;
+	bool compact, bottomup;
 	int d, i;
-	coord_value_t oldn, sz;
+	coord_value_t oldn, sz, frontier, unvisited;
+	struct timespec t;
 
 	alloc_ptable(coord, true);
 
@@ -194,20 +326,30 @@ gen_ptable(Coordinate *coord)
 	for (i = 0; i < 16; i++)
 		coord->count[i] = 0;
 
-	coord->updated = 0;
 	oldn = 0;
-	ptableupdate(coord, 0, 0);
-	gen_ptable_fixnasty(coord, 0, 0);
+	coord->updated = ptableupdate_atomic(coord, 0, 0) ? 1 : 0;
+	coord->updated += gen_ptable_fixnasty(coord, 0, 0);
 	fprintf(stderr, "\tDepth %d done, generated %"
 		PRIu32 "\t(%" PRIu32 "/%" PRIu32 ")\n",
 		0, coord->updated - oldn, coord->updated, coord->max);
 	oldn = coord->updated;
 	coord->count[0] = coord->updated;
+	bottomup = false;
 	for (d = 0; d < 15 && coord->updated < coord->max; d++) {
-		gen_ptable_bfs(coord, d);
+		frontier = coord->count[d];
+		unvisited = coord->max - coord->updated;
+		if (!bottomup && frontier > unvisited / BOTTOMUP_ALPHA)
+			bottomup = true;
+		if (bottomup && frontier < unvisited / BOTTOMUP_BETA)
+			bottomup = false;
+
+		clock_gettime(CLOCK_MONOTONIC, &t);
+		coord->updated += gen_ptable_bfs(coord, d, bottomup);
 		fprintf(stderr, "\tDepth %d done, generated %"
-			PRIu32 "\t(%" PRIu32 "/%" PRIu32 ")\n",
-			d+1, coord->updated-oldn, coord->updated, coord->max);
+			PRIu32 "\t(%" PRIu32 "/%" PRIu32 ")"
+			"\t%.3fs %s\n",
+			d+1, coord->updated-oldn, coord->updated, coord->max,
+			elapsed(&t), bottomup ? "bottom-up" : "top-down");
 		coord->count[d+1] = coord->updated - oldn;
 		oldn = coord->updated;
 	}
@@ -222,37 +364,80 @@ gen_ptable(Coordinate *coord)
 	fprintf(stderr, "%s: ptable generated\n", coord->name);
 }
 
-static void
-gen_ptable_bfs(Coordinate *coord, int d)
+static coord_value_t
+gen_ptable_bfs(Coordinate *coord, int d, bool bottomup)
+{
+	return run_threads(coord, coord->max, d, bottomup ?
+	    gen_ptable_bfs_bottomup_worker : gen_ptable_bfs_worker);
+}
+
+static void *
+gen_ptable_bfs_worker(void *a)
 {
+	GenArg *arg = a;
+	Coordinate *coord = arg->coord;
 	coord_value_t i, ii;
-	int pval;
 	Move m;
 
-	for (i = 0; i < coord->max; i++) {
-		pval = ptableval(coord, i);
-		if (pval != d)
+	for (i = arg->start; i < arg->end; i++) {
+		if (ptableval_atomic(coord, i) != arg->d)
 			continue;
 		for (m = U; m <= B3; m++) {
 			if (!coord->moveset(m))
 				continue;
 			ii = move_coord(coord, m, i, NULL);
-			ptableupdate(coord, ii, d+1);
-			gen_ptable_fixnasty(coord, ii, d+1);
+			if (ptableupdate_atomic(coord, ii, arg->d+1))
+				arg->updated++;
+			arg->updated += gen_ptable_fixnasty(coord, ii, arg->d+1);
 		}
 	}
+
+	return NULL;
 }
 
-static void
+/*
+ * Instead of expanding the entries at depth d, every unvisited entry looks
+ * for a neighbor at depth d. This works because all movesets are closed
+ * under inverses and under the symmetries used by the coordinates.
+ */
+static void *
+gen_ptable_bfs_bottomup_worker(void *a)
+{
+	GenArg *arg = a;
+	Coordinate *coord = arg->coord;
+	coord_value_t i, ii;
+	Move m;
+
+	for (i = arg->start; i < arg->end; i++) {
+		if (ptableval_atomic(coord, i) <= arg->d+1)
+			continue;
+		for (m = U; m <= B3; m++) {
+			if (!coord->moveset(m))
+				continue;
+			ii = move_coord(coord, m, i, NULL);
+			if (ptableval_atomic(coord, ii) != arg->d)
+				continue;
+			if (ptableupdate_atomic(coord, i, arg->d+1))
+				arg->updated++;
+			arg->updated += gen_ptable_fixnasty(coord, i, arg->d+1);
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+static coord_value_t
 gen_ptable_fixnasty(Coordinate *coord, coord_value_t i, int d)
 {
-	coord_value_t ii, ss, M;
+	coord_value_t ii, ss, M, updated;
 	int j;
 	Trans t;
 
 	if (coord->type != SYMCOMP_COORD)
-		return;
+		return 0;
 
+	updated = 0;
 	M = coord->base[1]->max;
 	ss = coord->base[0]->selfsim[i/M];
 	for (j = 0; j < coord->base[0]->tgrp->n; j++) {
@@ -260,10 +445,57 @@ gen_ptable_fixnasty(Coordinate *coord, coord_value_t i, int d)
 		if (t == uf || !(ss & ((coord_value_t)1<<t)))
 			continue;
 		ii = trans_coord(coord, t, i);
-		ptableupdate(coord, ii, d);
+		if (ptableupdate_atomic(coord, ii, d))
+			updated++;
 	}
+
+	return updated;
+}
+
+static int
+ptableval_atomic(Coordinate *coord, coord_value_t ind)
+{
+	int sh;
+	entry_group_t g;
+
+	sh = 4 * (ind % ENTRIES_PER_GROUP);
+	g = __atomic_load_n(
+	    &coord->ptable[ind/ENTRIES_PER_GROUP], __ATOMIC_RELAXED);
+
+	return (g >> sh) & 15;
 }
 
+/*
+ * Other threads may be writing to other entries of the same group, so we
+ * retry with a compare-and-swap on the whole group until either our value
+ * is written or someone else has already written a value that is not larger.
+ * Returns true if the entry was updated by this call.
+ */
+static bool
+ptableupdate_atomic(Coordinate *coord, coord_value_t ind, int n)
+{
+	int sh;
+	entry_group_t *g, old, new, mask;
+
+	sh = 4 * (ind % ENTRIES_PER_GROUP);
+	mask = ((entry_group_t)15) << sh;
+	g = &coord->ptable[ind/ENTRIES_PER_GROUP];
+	old = __atomic_load_n(g, __ATOMIC_RELAXED);
+	do {
+		if (((old & mask) >> sh) <= n)
+			return false;
+		new = (old & ~mask) | ((((entry_group_t)n)&15) << sh);
+	} while (!__atomic_compare_exchange_n(
+	    g, &old, new, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+	return true;
+}
+
+/*
+ * Entries are stored either as the distance modulo 3, with 3 for entries
+ * that were not reached, or as the distance minus ptablebase, where 0
+ * means "look up the base coordinates" and 3 means "at least 3".
+ */
 static void
 gen_ptable_compress(Coordinate *coord)
 {
@@ -278,8 +510,12 @@ gen_ptable_compress(Coordinate *coord)
 		for (j = 0; j < ENTRIES_PER_GROUP_COMPACT; j++) {
 			if (i+j >= coord->max)
 				break;
-			val = ptableval(coord, i+j) - coord->ptablebase;
-			v = (entry_group_t)MIN(3, MAX(0, val));
+			val = ptableval(coord, i+j);
+			if (coord->mod3)
+				v = (entry_group_t)(val == 15 ? 3 : val % 3);
+			else
+				v = (entry_group_t)MIN(3,
+				    MAX(0, val - coord->ptablebase));
 			mask |= v << (2*j);
 		}
 		coord->ptable[i/ENTRIES_PER_GROUP_COMPACT] = mask;
@@ -311,25 +547,48 @@ gen_ptable_setbase(Coordinate *coord)
 }
 
 int
-main(void)
+main(int argc, char *argv[])
 {
 	int i;
 	size_t b;
 	FILE *file;
 
-	init_cube();
+	for (i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-j") && i+1 < argc) {
+			nthreads = strtol(argv[++i], NULL, 10);
+		} else {
+			fprintf(stderr, "Usage: %s [-j threads]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (nthreads < 1 || nthreads > MAX_THREADS) {
+		fprintf(stderr, "Number of threads must be between 1 and %d\n",
+		    MAX_THREADS);
+		return 1;
+	}
+	fprintf(stderr, "Using %d threads\n", nthreads);
+
+	if (!check_cube()) {
+		fprintf(stderr, "src/cubedata.h is out of date, "
+		    "run \"make cubedata\"\n");
+		return 1;
+	}
 
-	b = 0;
-	for (i = 0; coordinates[i] != NULL; i++) {
+	for (i = 0; coordinates[i] != NULL; i++)
 		gen_coord(coordinates[i]);
-		b += write_coord(coordinates[i], &buf[b]);
-	}
 
-	if ((file = fopen("tables", "wb")) == NULL)
+	if ((file = fopen("tables", "wb")) == NULL) {
+		fprintf(stderr, "Cannot open tables for writing\n");
 		return 1;
+	}
 
-	if (fwrite(buf, 1, b, file) != b)
+	/* Buffered data is only written by fclose(), which can fail too */
+	b = write_tables(coordinates, writefile, file);
+	if (fclose(file) != 0 || b == 0) {
+		fprintf(stderr, "Error writing tables\n");
+		remove("tables");
 		return 1;
+	}
 
 	fprintf(stderr, "Written %zu bytes\n", b);
 
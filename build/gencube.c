@@ -0,0 +1,100 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "../src/cube.h"
+
+/*
+ * Writes to standard output the constant tables used by src/cube.c, as
+ * computed by gen_cube(). The output is src/cubedata.h.
+ */
+
+static void print_bytes(const uint8_t *, int);
+static void print_cube(const Cube *);
+static void print_cubes(char *, const Cube *, int);
+static void print_ints(int *, int);
+
+static void
+print_bytes(const uint8_t *a, int n)
+{
+	int i;
+
+	printf("{ ");
+	for (i = 0; i < n; i++)
+		printf("%d%s", a[i], i == n-1 ? " }" : ", ");
+}
+
+static void
+print_cube(const Cube *cube)
+{
+	printf("{\n\t\t.edge   = ");
+	print_bytes(cube->edge, 16);
+	printf(",\n\t\t.corner = ");
+	print_bytes(cube->corner, 16);
+	printf(",\n\t}");
+}
+
+static void
+print_cubes(char *name, const Cube *cubes, int n)
+{
+	int i;
+
+	printf("static const Cube %s[%d] = {\n", name, n);
+	for (i = 0; i < n; i++) {
+		printf("\t");
+		print_cube(&cubes[i]);
+		printf(",\n");
+	}
+	printf("};\n\n");
+}
+
+static void
+print_ints(int *a, int n)
+{
+	int i;
+
+	printf("\t{");
+	for (i = 0; i < n; i++)
+		printf("%s%d,", i % 16 ? " " : "\n\t\t", a[i]);
+	printf("\n\t},\n");
+}
+
+int
+main(void)
+{
+	int i, a[NMOVES_ALL];
+	Trans t, u;
+	Move m;
+	static CubeData d;
+
+	gen_cube(&d);
+
+	printf("/* Generated by build/gencube.c, do not edit */\n\n");
+
+	print_cubes("move_array", d.move_array, NMOVES_ALL);
+	print_cubes("trans_pre", d.trans_pre, NTRANS);
+	print_cubes("trans_post", d.trans_post, NTRANS);
+
+	printf("static const Move moves_ttable[NTRANS][NMOVES_ALL] = {\n");
+	for (t = 0; t < NTRANS; t++) {
+		for (m = 0; m < NMOVES_ALL; m++)
+			a[m] = d.moves_ttable[t][m];
+		print_ints(a, NMOVES_ALL);
+	}
+	printf("};\n\n");
+
+	printf("static const Trans trans_ttable[NTRANS][NTRANS] = {\n");
+	for (t = 0; t < NTRANS; t++) {
+		for (u = 0; u < NTRANS; u++)
+			a[u] = d.trans_ttable[t][u];
+		print_ints(a, NTRANS);
+	}
+	printf("};\n\n");
+
+	printf("static const Trans trans_itable[NTRANS] = {");
+	for (i = 0; i < NTRANS; i++)
+		printf("%s%d,", i % 16 ? " " : "\n\t", d.trans_itable[i]);
+	printf("\n};\n");
+
+	return 0;
+}
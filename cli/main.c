@@ -1,28 +1,49 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "../src/nissy.h"
 
-#define MAX_SOLS 999
+static void print_sol(char *, void *);
+static void print_label(char *, char *, void *);
 
-static char buf[TABLESFILESIZE];
+static void
+print_sol(char *sol, void *data)
+{
+	printf("%s\n", sol);
+}
+
+static void
+print_label(char *trans, char *sol, void *data)
+{
+	printf("%s: %s\n", trans, sol);
+}
 
 int
 main(int argc, char *argv[])
 {
-	char sols[99999];
-	FILE *file;
-	long size;
+	int threads = 1;
+	int max = 0;
+	int optimal = -1;
+	char *end, *end2;
 
-	if ((file = fopen("tables", "rb")) == NULL)
+	if (nissy_init_lazy("tables") != 0) {
+		fprintf(stderr, "Error reading tables\n");
 		return -2;
+	}
 
-	fseek(file, 0, SEEK_END);
-	size = ftell(file);
-	rewind(file);
-	fread(buf, 1, size, file);
-
-	nissy_init(buf);
+	for (; argc > 2 && argv[1][0] == '-'; argc -= 2, argv += 2) {
+		if (!strcmp(argv[1], "-j")) {
+			threads = strtol(argv[2], NULL, 10);
+		} else if (!strcmp(argv[1], "-o")) {
+			optimal = strtol(argv[2], NULL, 10);
+		} else if (!strcmp(argv[1], "-n")) {
+			max = strtol(argv[2], NULL, 10);
+		} else {
+			fprintf(stderr, "Unknown option: %s\n", argv[1]);
+			return -1;
+		}
+	}
 
 	if (argc != 6) {
 		fprintf(stderr, "Not enough arguments given\n");
@@ -31,25 +52,49 @@ main(int argc, char *argv[])
 
 	char *step = argv[1];
 	char *trans = argv[2];
-	int d = strtol(argv[3], NULL, 10);
+	/* The depth can also be given as a range, for example 3-7 */
+	int mind = strtol(argv[3], &end, 10);
+	int maxd = *end == '-' ? strtol(end+1, &end2, 10) : mind;
 	char *type = argv[4];
 	char *scramble = argv[5];
 
-	switch (nissy_solve(step, trans, d, type, scramble, sols)) {
+	if (end == argv[3] || (*end != '\0' && *end != '-') ||
+	    (*end == '-' && (end2 == end+1 || *end2 != '\0')) ||
+	    mind < 0 || maxd < mind) {
+		fprintf(stderr, "Invalid depth: %s\n", argv[3]);
+		return -1;
+	}
+
+	/* A list of transformations is solved all at once */
+	int multi = strchr(trans, ' ') || strchr(trans, ',') ||
+	    !strcmp(trans, "all");
+
+	switch (multi ?
+	    nissy_solve_multi(step, trans, mind, maxd, optimal, type,
+	        scramble, print_label, NULL, threads, max) :
+	    nissy_solve_cb(step, trans, mind, maxd, optimal, type,
+	        scramble, print_sol, NULL, threads, max)) {
 	case 1:
 		fprintf(stderr, "Error parsing step: %s\n", step);
 		return -1;
 	case 2:
 		fprintf(stderr, "Error parsing trans: %s\n", trans);
 		return -1;
-	case 4:
+	case 3:
+		fprintf(stderr, "Invalid depth: %s\n", argv[3]);
+		return -1;
+	case 6:
 		fprintf(stderr, "Error parsing type: %s\n", type);
 		return -1;
-	case 5:
+	case 7:
 		fprintf(stderr, "Error applying scramble: %s\n", scramble);
 		return -1;
-	default:
-		printf("%s", sols);
+	case 10:
+		fprintf(stderr, "Invalid number of threads: %d\n", threads);
+		return -1;
+	case 11:
+		fprintf(stderr, "Invalid number of solutions: %d\n", max);
+		return -1;
 	}
 
 	return 0;
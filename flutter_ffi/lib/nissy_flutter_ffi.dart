@@ -16,9 +16,12 @@ void nissy_init(ByteData tables) {
   for (var i = 0; i < n; i++) {
     tablesHeap[i] = tablesList[i];
   }
-  _bindings.nissy_init(tablesHeap);
+  _bindings.nissy_init(tablesHeap, n);
+  calloc.free(tablesHeap);
 }
 
+void nissy_free() => _bindings.nissy_free();
+
 String ptrCharToString(Pointer<Char> ptr) => ptr.cast<Utf8>().toDartString();
 Pointer<Char> stringToPtrChar(String str) {
   final n = str.length;
@@ -49,12 +52,23 @@ List<String> nissy_eos_in(String scr, int n) {
 
   print('Doing thing...');
 
-  var bufferPtr = calloc<Char>(5000); // hope it is enough
-  final nsols = _bindings.nissy_solve(eofb, uf, n, normal, scramble, bufferPtr);
+  // Start with a small buffer, try again if it is not large enough
+  var size = 5000;
+  var bufferPtr = calloc<Char>(size);
+  final neededPtr = calloc<Size>();
+  while (true) {
+    _bindings.nissy_solve_buf(eofb, uf, n, n, -1, normal, scramble,
+        bufferPtr, size, neededPtr, Platform.numberOfProcessors, 0);
+    if (neededPtr.value <= size) break;
+    size = neededPtr.value;
+    calloc.free(bufferPtr);
+    bufferPtr = calloc<Char>(size);
+  }
   ret.add(ptrCharToString(bufferPtr));
 
   print('Ret 0: ' + ret[0]);
 
+  calloc.free(neededPtr);
   calloc.free(bufferPtr);
   calloc.free(normal);
   calloc.free(uf);
@@ -1,21 +1,86 @@
+#ifdef __linux__
+#define _DEFAULT_SOURCE
+#endif
+
 #include <inttypes.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
 #include "cube.h"
 #include "coord.h"
 
-typedef void (Copier)(void *, void *, size_t);
-
-static size_t copy_coord_sd(Coordinate *, char *, Copier *);
-static size_t copy_coord_mtable(Coordinate *, char *, Copier *);
-static size_t copy_coord_ttrep_move(Coordinate *, char *, Copier *);
-static size_t copy_coord_ttable(Coordinate *, char *, Copier *);
-static size_t copy_ptable(Coordinate *, char *, Copier *);
-
-static void readin  (void *t, void *b, size_t n) { memcpy(t, b, n); }
-static void writeout(void *t, void *b, size_t n) { memcpy(b, t, n); }
+/*
+ * A Copier moves data between Coordinates and a tables file, one section
+ * at a time. The file is either a buffer or a stream accessed through a
+ * TablesIO callback; if neither is given, the Copier only counts bytes.
+ * When reading from a buffer that is kept alive (e.g. a memory-mapped
+ * file), tables can be pointed to instead of copied; otherwise they are
+ * carved out of a single arena, allocated once the sizes of the sections
+ * to read are known.
+ */
+typedef struct {
+	bool in;
+	bool map;
+	char *buf;
+	size_t size;
+	TablesIO *io;
+	void *data;
+	size_t pos;
+	bool error;
+	char *arena;
+	size_t arenasize;
+	size_t arenapos;
+} Copier;
+
+/*
+ * Every arena starts with an Arena header, so that all of them can be
+ * released by free_tables(). Large arenas are aligned to a huge page.
+ */
+typedef struct arena {
+	struct arena *next;
+	void *mem;
+} Arena;
+
+/*
+ * The tables file starts with a TablesHeader, followed by one TablesEntry
+ * for each coordinate. Each entry points to the section containing the
+ * data of that coordinate. Sections and every table inside them start at
+ * a multiple of TABLES_ALIGN. Sections appear in the same order as the
+ * coordinates they were written from.
+ */
+typedef struct {
+	char magic[8];
+	uint32_t version;
+	uint32_t n;
+} TablesHeader;
+typedef struct {
+	char name[32];
+	uint64_t offset;
+	uint64_t size;
+} TablesEntry;
+
+static size_t aligned(size_t);
+static char *alloc_arena(uint64_t);
+static void copy_bytes(Copier *, void *, size_t);
+static void copy_pad(Copier *, size_t);
+static void *copy_table(Copier *, void *, size_t);
+static void copy_coord_sd(Coordinate *, Copier *);
+static void copy_coord_mtable(Coordinate *, Copier *);
+static void copy_coord_ttrep_move(Coordinate *, Copier *);
+static void copy_coord_ttable(Coordinate *, Copier *);
+static void copy_ptable(Coordinate *, Copier *);
+static bool copy_width(Coordinate *, Copier *);
+static bool copy_layout(Coordinate *, Copier *);
+static bool copy_mod3(Coordinate *, Copier *);
+static size_t copy_coord(Coordinate *, Copier *);
+static bool copy_tables(Coordinate *[], Copier *);
+
+static Arena *arenas;
 
 coord_value_t
 indexers_getmax(Indexer **is)
@@ -62,14 +127,38 @@ indexers_makecube(Indexer **is, coord_value_t ind, Cube *c)
 	}
 }
 
+void
+set_width(Coordinate *coord)
+{
+	coord->width = coord->max <= UINT16_MAX + 1 ? 2 : 4;
+}
+
+coord_value_t
+tableval(Coordinate *coord, void *table, coord_value_t i)
+{
+	if (coord->width == 2)
+		return ((uint16_t *)table)[i];
+
+	return ((uint32_t *)table)[i];
+}
+
+void
+tableset(Coordinate *coord, void *table, coord_value_t i, coord_value_t v)
+{
+	if (coord->width == 2)
+		((uint16_t *)table)[i] = v;
+	else
+		((uint32_t *)table)[i] = v;
+}
+
 void
 alloc_sd(Coordinate *coord, bool gen)
 {
 	size_t M;
 
 	M = coord->base[0]->max;
-	coord->symclass = malloc(M * sizeof(coord_value_t));
-	coord->transtorep = malloc(M * sizeof(Trans));
+	coord->symclass = malloc(M * coord->width);
+	coord->transtorep = malloc(M);
 	if (gen) {
 		coord->selfsim = malloc(M * sizeof(coord_value_t));
 		coord->symrep = malloc(M * sizeof(coord_value_t));
@@ -80,18 +169,35 @@ void
 alloc_mtable(Coordinate *coord)
 {
 	Move m;
+	char *t;
+
+	coord->mstride = coord->indexmajor ? NMOVES_HTM : 1;
+	if (coord->indexmajor) {
+		t = malloc(NMOVES_HTM * coord->max * coord->width);
+		for (m = 0; m < NMOVES_HTM; m++)
+			coord->mtable[m] = t + m * coord->width;
+		return;
+	}
 
 	for (m = 0; m < NMOVES_HTM; m++)
-		coord->mtable[m] = malloc(coord->max * sizeof(coord_value_t));
+		coord->mtable[m] = malloc(coord->max * coord->width);
 }
 
 void
 alloc_ttrep_move(Coordinate *coord)
 {
 	Move m;
+	uint8_t *t;
+
+	if (coord->indexmajor) {
+		t = malloc(NMOVES_HTM * coord->max);
+		for (m = 0; m < NMOVES_HTM; m++)
+			coord->ttrep_move[m] = t + m;
+		return;
+	}
 
 	for (m = 0; m < NMOVES_HTM; m++)
-		coord->ttrep_move[m] = malloc(coord->max * sizeof(Trans));
+		coord->ttrep_move[m] = malloc(coord->max);
 }
 
 void
@@ -100,7 +206,7 @@ alloc_ttable(Coordinate *coord)
 	Trans t;
 
 	for (t = 0; t < NTRANS; t++)
-		coord->ttable[t] = malloc(coord->max * sizeof(coord_value_t));
+		coord->ttable[t] = malloc(coord->max * coord->width);
 }
 
 void
@@ -108,101 +214,231 @@ alloc_ptable(Coordinate *coord, bool gen)
 {
 	size_t sz;
 
-	coord->compact = coord->base[1] != NULL;
+	coord->compact = coord->base[1] != NULL || coord->mod3;
 	sz = ptablesize(coord) * (coord->compact && gen ? 2 : 1);
 	coord->ptable = malloc(sz * sizeof(entry_group_t));
 }
 
 static size_t
-copy_coord_mtable(Coordinate *coord, char *buf, Copier *copy)
+aligned(size_t n)
 {
-	Move m;
-	size_t b, rowsize;
+	return (n + TABLES_ALIGN - 1) / TABLES_ALIGN * TABLES_ALIGN;
+}
 
-	b = 0;
-	rowsize = coord->max * sizeof(coord_value_t);
-	for (m = 0; m < NMOVES_HTM; m++) {
-		copy(coord->mtable[m], &buf[b], rowsize);
-		b += rowsize;
+static char *
+alloc_arena(uint64_t size)
+{
+	size_t align, hsize;
+	char *mem, *a;
+	Arena *arena;
+
+	align = size >= HUGEPAGE_SIZE ? HUGEPAGE_SIZE : TABLES_ALIGN;
+	hsize = aligned(sizeof(Arena));
+	if (size > SIZE_MAX - hsize - align ||
+	    (mem = malloc(hsize + size + align)) == NULL)
+		return NULL;
+
+	a = mem + (align - (uintptr_t)mem % align) % align;
+#ifdef MADV_HUGEPAGE
+	if (align == HUGEPAGE_SIZE)
+		madvise(a, hsize + size, MADV_HUGEPAGE);
+#endif
+
+	arena = (Arena *)a;
+	arena->mem = mem;
+	arena->next = arenas;
+	arenas = arena;
+
+	return a + hsize;
+}
+
+static void
+copy_bytes(Copier *copy, void *t, size_t n)
+{
+	if (copy->error)
+		return;
+
+	if (copy->io != NULL) {
+		if (copy->io(copy->data, t, n) != n)
+			copy->error = true;
+	} else if (copy->buf != NULL) {
+		if (n > copy->size - copy->pos)
+			copy->error = true;
+		else if (copy->in)
+			memcpy(t, &copy->buf[copy->pos], n);
+		else
+			memcpy(&copy->buf[copy->pos], t, n);
 	}
 
-	return b;
+	copy->pos += n;
 }
 
-static size_t
-copy_coord_ttrep_move(Coordinate *coord, char *buf, Copier *copy)
+static void
+copy_pad(Copier *copy, size_t n)
 {
-	Move m;
-	size_t b, rowsize;
+	char zero[TABLES_ALIGN] = {0};
 
-	b = 0;
-	rowsize = coord->max * sizeof(Trans);
-	for (m = 0; m < NMOVES_HTM; m++) {
-		copy(coord->ttrep_move[m], &buf[b], rowsize);
-		b += rowsize;
+	/* Skipping in a buffer must not touch it, it may be mapped */
+	if (copy->in && copy->io == NULL) {
+		if (n > copy->size - copy->pos)
+			copy->error = true;
+		copy->pos += n;
+		return;
 	}
 
-	return b;
+	for ( ; n > TABLES_ALIGN; n -= TABLES_ALIGN)
+		copy_bytes(copy, zero, TABLES_ALIGN);
+	copy_bytes(copy, zero, n);
 }
 
-static size_t
-copy_coord_sd(Coordinate *coord, char *buf, Copier *copy)
+static void *
+copy_table(Copier *copy, void *t, size_t n)
 {
-	size_t b, size_max, rowsize_ttr, rowsize_symc;
+	copy_pad(copy, aligned(copy->pos) - copy->pos);
+
+	if (copy->map) {
+		if (copy->error || n > copy->size - copy->pos)
+			copy->error = true;
+		else
+			t = &copy->buf[copy->pos];
+		copy->pos += n;
+	} else {
+		if (copy->in && n > copy->arenasize - copy->arenapos) {
+			copy->error = true;
+			return t;
+		}
+		if (copy->in) {
+			t = &copy->arena[copy->arenapos];
+			copy->arenapos += aligned(n);
+		}
+		copy_bytes(copy, t, n);
+	}
 
-	b = 0;
+	copy_pad(copy, aligned(copy->pos) - copy->pos);
 
-	size_max = sizeof(coord_value_t);
-	copy(&coord->max, &buf[b], size_max);
-	b += size_max;
+	return t;
+}
 
-	rowsize_ttr = coord->base[0]->max * sizeof(Trans);
-	copy(coord->transtorep, &buf[b], rowsize_ttr);
-	b += rowsize_ttr;
+/* Index-major tables are a single table instead of one per move */
+static void
+copy_coord_mtable(Coordinate *coord, Copier *copy)
+{
+	Move m;
+	size_t rowsize;
+	char *t;
+
+	rowsize = coord->max * coord->width;
+	coord->mstride = coord->indexmajor ? NMOVES_HTM : 1;
+	if (coord->indexmajor) {
+		t = copy_table(copy, coord->mtable[0], NMOVES_HTM * rowsize);
+		for (m = 0; m < NMOVES_HTM; m++)
+			coord->mtable[m] = t + m * coord->width;
+		return;
+	}
 
-	rowsize_symc = coord->base[0]->max * sizeof(coord_value_t);
-	copy(coord->symclass, &buf[b], rowsize_symc);
-	b += rowsize_symc;
+	for (m = 0; m < NMOVES_HTM; m++)
+		coord->mtable[m] = copy_table(copy, coord->mtable[m], rowsize);
+}
 
-	return b;
+static void
+copy_coord_ttrep_move(Coordinate *coord, Copier *copy)
+{
+	Move m;
+	size_t rowsize;
+	uint8_t *t;
+
+	rowsize = coord->max;
+	if (coord->indexmajor) {
+		t = copy_table(copy, coord->ttrep_move[0], NMOVES_HTM * rowsize);
+		for (m = 0; m < NMOVES_HTM; m++)
+			coord->ttrep_move[m] = t + m;
+		return;
+	}
+
+	for (m = 0; m < NMOVES_HTM; m++)
+		coord->ttrep_move[m] =
+		    copy_table(copy, coord->ttrep_move[m], rowsize);
 }
 
-static size_t
-copy_coord_ttable(Coordinate *coord, char *buf, Copier *copy)
+static void
+copy_coord_sd(Coordinate *coord, Copier *copy)
 {
-	Trans t;
-	size_t b, rowsize;
+	size_t rowsize_ttr, rowsize_symc;
 
-	b = 0;
-	rowsize = coord->max * sizeof(coord_value_t);
-	for (t = 0; t < NTRANS; t++) {
-		copy(coord->ttable[t], &buf[b], rowsize);
-		b += rowsize;
-	}
+	copy_bytes(copy, &coord->max, sizeof(coord_value_t));
 
-	return b;
+	rowsize_ttr = coord->base[0]->max;
+	coord->transtorep = copy_table(copy, coord->transtorep, rowsize_ttr);
+
+	rowsize_symc = coord->base[0]->max * coord->width;
+	coord->symclass = copy_table(copy, coord->symclass, rowsize_symc);
 }
 
-static size_t
-copy_ptable(Coordinate *coord, char *buf, Copier *copy)
+static void
+copy_coord_ttable(Coordinate *coord, Copier *copy)
 {
-	size_t b, size_base, size_count, size_ptable;
+	Trans t;
+	size_t rowsize;
 
-	b = 0;
+	rowsize = coord->max * coord->width;
+	for (t = 0; t < NTRANS; t++)
+		coord->ttable[t] = copy_table(copy, coord->ttable[t], rowsize);
+}
 
-	size_base = sizeof(coord->ptablebase);
-	copy(&coord->ptablebase, &buf[b], size_base);
-	b += size_base;
+static void
+copy_ptable(Coordinate *coord, Copier *copy)
+{
+	size_t size_ptable;
 
-	size_count = 16 * sizeof(coord_value_t);
-	copy(&coord->count, &buf[b], size_count);
-	b += size_count;
+	copy_bytes(copy, &coord->ptablebase, sizeof(coord->ptablebase));
+	copy_bytes(copy, &coord->count, 16 * sizeof(coord_value_t));
 
 	size_ptable = ptablesize(coord) * sizeof(entry_group_t);
-	copy(coord->ptable, &buf[b], size_ptable);
-	b += size_ptable;
+	coord->ptable = copy_table(copy, coord->ptable, size_ptable);
+}
+
+static bool
+copy_width(Coordinate *coord, Copier *copy)
+{
+	copy_bytes(copy, &coord->width, sizeof(coord->width));
+	if (coord->width != 2 && coord->width != 4)
+		copy->error = true;
+
+	return !copy->error;
+}
+
+/* The layout of mtable and ttrep_move, 1 if they are index-major */
+static bool
+copy_layout(Coordinate *coord, Copier *copy)
+{
+	uint8_t l;
+
+	l = coord->indexmajor;
+	copy_bytes(copy, &l, sizeof(l));
+	if (l > 1)
+		copy->error = true;
+	coord->indexmajor = l;
 
-	return b;
+	return !copy->error;
+}
+
+/*
+ * Whether the pruning table holds distances modulo 3, which decides how it
+ * is read. The one found in the tables file is used.
+ */
+static bool
+copy_mod3(Coordinate *coord, Copier *copy)
+{
+	uint8_t m;
+
+	m = coord->mod3;
+	copy_bytes(copy, &m, sizeof(m));
+	if (m > 1)
+		copy->error = true;
+	coord->mod3 = m;
+	coord->compact = coord->type == SYMCOMP_COORD || coord->mod3;
+
+	return !copy->error;
 }
 
 coord_value_t
@@ -224,7 +460,7 @@ index_coord(Coordinate *coord, Cube *cube, Trans *offtrans)
 		if (offtrans != NULL)
 			*offtrans = ttr;
 
-		return coord->symclass[cnosym];
+		return tableval(coord, coord->symclass, cnosym);
 	case SYMCOMP_COORD:
 		c[0] = index_coord(coord->base[0], cube, NULL);
 		cnosym = index_coord(coord->base[0]->base[0], cube, NULL);
@@ -258,22 +494,22 @@ move_coord(Coordinate *coord, Move m, coord_value_t ind, Trans *offtrans)
 		if (offtrans != NULL)
 			*offtrans = uf;
 
-		return coord->mtable[m][ind];
+		return tableval(coord, coord->mtable[m], ind * coord->mstride);
 	case SYM_COORD:
-		ttr = coord->ttrep_move[m][ind];
+		ttr = coord->ttrep_move[m][ind * coord->mstride];
 
 		if (offtrans != NULL)
 			*offtrans = ttr;
 
-		return coord->mtable[m][ind];
+		return tableval(coord, coord->mtable[m], ind * coord->mstride);
 	case SYMCOMP_COORD:
 		M = coord->base[1]->max;
-		i[0] = ind / M;
-		i[1] = ind % M;
+		i[0] = ind / M * coord->base[0]->mstride;
+		i[1] = ind % M * coord->base[1]->mstride;
 		ttr = coord->base[0]->ttrep_move[m][i[0]];
-		i[0] = coord->base[0]->mtable[m][i[0]];
-		i[1] = coord->base[1]->mtable[m][i[1]];
-		i[1] = coord->base[1]->ttable[ttr][i[1]];
+		i[0] = tableval(coord->base[0], coord->base[0]->mtable[m], i[0]);
+		i[1] = tableval(coord->base[1], coord->base[1]->mtable[m], i[1]);
+		i[1] = tableval(coord->base[1], coord->base[1]->ttable[ttr], i[1]);
 
 		if (offtrans != NULL)
 			*offtrans = ttr;
@@ -297,14 +533,14 @@ trans_coord(Coordinate *coord, Trans t, coord_value_t ind)
 
 	switch (coord->type) {
 	case COMP_COORD:
-		return coord->ttable[t][ind];
+		return tableval(coord, coord->ttable[t], ind);
 	case SYM_COORD:
 		return ind;
 	case SYMCOMP_COORD:
 		M = coord->base[1]->max;
 		i[0] = ind / M; /* Always fixed */
 		i[1] = ind % M;
-		i[1] = coord->base[1]->ttable[t][i[1]];
+		i[1] = tableval(coord->base[1], coord->base[1]->ttable[t], i[1]);
 		return i[0] * M + i[1];
 	default:
 		break;
@@ -323,25 +559,11 @@ ptablesize(Coordinate *coord)
 	return (coord->max + e - 1) / e;
 }
 
-void
-ptableupdate(Coordinate *coord, coord_value_t ind, int n)
-{
-	int sh;
-	entry_group_t mask;
-	coord_value_t i;
-
-	if (ptableval(coord, ind) <= n)
-		return;
-
-	sh = 4 * (ind % ENTRIES_PER_GROUP);
-	mask = ((entry_group_t)15) << sh;
-	i = ind/ENTRIES_PER_GROUP;
-	coord->ptable[i] &= ~mask;
-	coord->ptable[i] |= (((entry_group_t)n)&15) << sh;
-
-	coord->updated++;
-}
-
+/*
+ * For mod3 coordinates this is the distance modulo 3, or 3 if the entry
+ * was not reached, use ptabledist() or ptableneighbor() to get the
+ * actual distance.
+ */
 int
 ptableval(Coordinate *coord, coord_value_t ind)
 {
@@ -352,6 +574,8 @@ ptableval(Coordinate *coord, coord_value_t ind)
 		e  = ENTRIES_PER_GROUP_COMPACT;
 		sh = (ind % e) * 2;
 		ret = (coord->ptable[ind/e] & (3 << sh)) >> sh;
+		if (coord->mod3)
+			return ret;
 		if (ret != 0)
 			return ret + coord->ptablebase;
 		for (j = 0; j < 2 && coord->base[j] != NULL; j++) ;
@@ -369,73 +593,261 @@ ptableval(Coordinate *coord, coord_value_t ind)
 	return (coord->ptable[ind/e] & (15 << sh)) >> sh;
 }
 
+/* True if ptableval() looks up the base coordinates of coord for ind */
+bool
+ptablefallback(Coordinate *coord, coord_value_t ind)
+{
+	int sh;
+	coord_value_t e;
+
+	if (!coord->compact || coord->mod3)
+		return false;
+
+	e  = ENTRIES_PER_GROUP_COMPACT;
+	sh = (ind % e) * 2;
+	return !(coord->ptable[ind/e] & (3 << sh));
+}
+
+/*
+ * With mod3 tables the distance is found by following moves that decrease
+ * it by one, until there are none: the neighbors of a position at distance
+ * 0 are at distance 0 or 1, never 2 modulo 3.
+ */
+int
+ptabledist(Coordinate *coord, coord_value_t ind)
+{
+	int d, v;
+	coord_value_t ii;
+	Move m;
+
+	if (!coord->mod3)
+		return ptableval(coord, ind);
+
+	if ((v = ptableval(coord, ind)) == 3)
+		return 15;
+
+	for (d = 0; ; d++, v = (v+2) % 3, ind = ii) {
+		for (m = U; m <= B3; m++) {
+			if (!coord->moveset(m))
+				continue;
+			ii = move_coord(coord, m, ind, NULL);
+			if (ptableval(coord, ii) == (v+2) % 3)
+				break;
+		}
+		if (m > B3)
+			return d;
+	}
+}
+
+/* The distance of ind, given the distance d of one of its neighbors */
+int
+ptableneighbor(Coordinate *coord, coord_value_t ind, int d)
+{
+	int v;
+
+	if (!coord->mod3)
+		return ptableval(coord, ind);
+
+	if ((v = ptableval(coord, ind)) == 3)
+		return 15;
+
+	return d + (v - d%3 + 4) % 3 - 1;
+}
+
+/*
+ * Hints that ptableval(coord, ind) is going to be called soon. For compact
+ * tables only the entry of coord itself is fetched, not those of its
+ * base coordinates that are looked up when it is 0.
+ */
+void
+ptableprefetch(Coordinate *coord, coord_value_t ind)
+{
+#if defined(__GNUC__)
+	coord_value_t e;
+
+	e = coord->compact ? ENTRIES_PER_GROUP_COMPACT : ENTRIES_PER_GROUP;
+	__builtin_prefetch(&coord->ptable[ind/e]);
+#endif
+}
+
 static size_t
-copy_coord(Coordinate *coord, char *buf, bool alloc, Copier *copy)
+copy_coord(Coordinate *coord, Copier *copy)
 {
 	size_t b;
 
-	b = 0;
+	b = copy->pos;
 	switch (coord->type) {
 	case COMP_COORD:
-		if (alloc) {
+		if (copy->in)
 			coord->max = indexers_getmax(coord->i);
-			alloc_mtable(coord);
-		}
-		b += copy_coord_mtable(coord, &buf[b], copy);
-
-		if (alloc)
-			alloc_ttable(coord);
-		b += copy_coord_ttable(coord, &buf[b], copy);
-
-		if (alloc)
-			alloc_ptable(coord, false);
-		b += copy_ptable(coord, &buf[b], copy);
+		if (!copy_width(coord, copy) || !copy_layout(coord, copy) ||
+		    !copy_mod3(coord, copy))
+			break;
+		copy_coord_mtable(coord, copy);
+		copy_coord_ttable(coord, copy);
+		copy_ptable(coord, copy);
 
 		break;
 	case SYM_COORD:
-		if (alloc) {
+		if (copy->in)
 			coord->base[0]->max =
 			    indexers_getmax(coord->base[0]->i);
-			alloc_sd(coord, false);
-		}
-		b += copy_coord_sd(coord, &buf[b], copy);
-
-		if (alloc)
-			alloc_mtable(coord);
-		b += copy_coord_mtable(coord, &buf[b], copy);
-
-		if (alloc)
-			alloc_ttrep_move(coord);
-		b += copy_coord_ttrep_move(coord, &buf[b], copy);
-
-		if (alloc)
-			alloc_ptable(coord, false);
-		b += copy_ptable(coord, &buf[b], copy);
+		if (!copy_width(coord, copy) || !copy_layout(coord, copy) ||
+		    !copy_mod3(coord, copy))
+			break;
+		copy_coord_sd(coord, copy);
+		copy_coord_mtable(coord, copy);
+		copy_coord_ttrep_move(coord, copy);
+		copy_ptable(coord, copy);
 
 		break;
 	case SYMCOMP_COORD:
-		if (alloc) {
+		if (copy->in)
 			coord->max = coord->base[0]->max * coord->base[1]->max;
-			alloc_ptable(coord, false);
-		}
-		b += copy_ptable(coord, &buf[b], copy);
+		if (!copy_mod3(coord, copy))
+			break;
+		copy_ptable(coord, copy);
 
 		break;
 	default:
 		break;
 	}
 
-	return b;
+	return copy->pos - b;
 }
 
-size_t
-read_coord(Coordinate *coord, char *buf)
+static bool
+copy_tables(Coordinate *coord[], Copier *copy)
+{
+	uint32_t i, j, found;
+	uint64_t total;
+	TablesHeader h;
+	TablesEntry *e;
+
+	copy_bytes(copy, &h, sizeof(h));
+	if (copy->error || memcmp(h.magic, TABLES_MAGIC, sizeof(h.magic)) ||
+	    h.version != TABLES_VERSION)
+		return false;
+
+	/* A buffer cannot hold more than its size, whatever the header says */
+	if (copy->buf != NULL && h.n > copy->size / sizeof(TablesEntry))
+		return false;
+	if ((e = malloc(h.n * sizeof(TablesEntry))) == NULL)
+		return false;
+	copy_bytes(copy, e, h.n * sizeof(TablesEntry));
+
+	/* Every table takes at most its aligned size in its section */
+	if (copy->in && !copy->map && !copy->error) {
+		for (j = 0, total = 0; j < h.n; j++)
+			for (i = 0; coord[i] != NULL; i++)
+				if (!strncmp(e[j].name, coord[i]->name,
+				    sizeof(e->name)))
+					total += e[j].size;
+		if (copy->buf != NULL && total > copy->size)
+			copy->error = true;
+		else if (total > 0 && (copy->arena = alloc_arena(total)) == NULL)
+			copy->error = true;
+		copy->arenasize = copy->arena == NULL ? 0 : total;
+	}
+
+	/* Sections are read in file order, skipping unknown coordinates */
+	for (j = 0, found = 0; j < h.n && !copy->error; j++) {
+		for (i = 0; coord[i] != NULL; i++)
+			if (!strncmp(e[j].name, coord[i]->name, sizeof(e->name)))
+				break;
+		if (coord[i] == NULL)
+			continue;
+
+		if (e[j].offset < copy->pos || e[j].offset % TABLES_ALIGN) {
+			copy->error = true;
+			break;
+		}
+		copy_pad(copy, e[j].offset - copy->pos);
+		if (copy_coord(coord[i], copy) != e[j].size)
+			copy->error = true;
+		coord[i]->generated = !copy->error;
+		found++;
+	}
+	free(e);
+
+	for (i = 0; coord[i] != NULL; i++) ;
+
+	return !copy->error && found == i;
+}
+
+void
+free_tables(Coordinate *coord[])
+{
+	int i;
+	Arena *a;
+
+	for (i = 0; coord[i] != NULL; i++)
+		coord[i]->generated = false;
+
+	while ((a = arenas) != NULL) {
+		arenas = a->next;
+		free(a->mem);
+	}
+}
+
+bool
+read_tables(Coordinate *coord[], char *buf, size_t size)
 {
-	return copy_coord(coord, buf, true, readin);
+	Copier copy = { .in = true, .buf = buf, .size = size };
+
+	return copy_tables(coord, &copy);
+}
+
+bool
+read_tables_stream(Coordinate *coord[], TablesIO *io, void *data)
+{
+	Copier copy = { .in = true, .io = io, .data = data };
+
+	return copy_tables(coord, &copy);
+}
+
+bool
+map_tables(Coordinate *coord[], char *buf, size_t size)
+{
+	Copier copy = { .in = true, .map = true, .buf = buf, .size = size };
+
+	return copy_tables(coord, &copy);
 }
 
 size_t
-write_coord(Coordinate *coord, char *buf)
+write_tables(Coordinate *coord[], TablesIO *io, void *data)
 {
-	return copy_coord(coord, buf, false, writeout);
+	uint32_t i;
+	size_t b;
+	TablesHeader h;
+	TablesEntry *e;
+	Copier count = { .in = false };
+	Copier copy = { .in = false, .io = io, .data = data };
+
+	memcpy(h.magic, TABLES_MAGIC, sizeof(h.magic));
+	h.version = TABLES_VERSION;
+	for (h.n = 0; coord[h.n] != NULL; h.n++) ;
+
+	if ((e = calloc(h.n, sizeof(TablesEntry))) == NULL)
+		return 0;
+
+	/* A first pass computes the offsets, so the header can go first */
+	b = aligned(sizeof(h) + h.n * sizeof(TablesEntry));
+	for (i = 0; i < h.n; i++) {
+		strncpy(e[i].name, coord[i]->name, sizeof(e->name) - 1);
+		e[i].offset = b;
+		count.pos = b;
+		e[i].size = copy_coord(coord[i], &count);
+		b = aligned(b + e[i].size);
+	}
+
+	copy_bytes(&copy, &h, sizeof(h));
+	copy_bytes(&copy, e, h.n * sizeof(TablesEntry));
+	for (i = 0; i < h.n; i++) {
+		copy_pad(&copy, e[i].offset - copy.pos);
+		copy_coord(coord[i], &copy);
+	}
+	free(e);
+
+	return copy.error ? 0 : copy.pos;
 }
@@ -1,9 +1,15 @@
 #define ENTRIES_PER_GROUP         (2*sizeof(entry_group_t))
 #define ENTRIES_PER_GROUP_COMPACT (4*sizeof(entry_group_t))
 
+#define TABLES_MAGIC   "nissytab"
+#define TABLES_VERSION 5
+#define TABLES_ALIGN   64
+#define HUGEPAGE_SIZE  (2 << 20)
+
 typedef uint8_t entry_group_t;
 typedef uint32_t coord_value_t;
 typedef bool (Moveset)(Move);
+typedef size_t (TablesIO)(void *, void *, size_t);
 typedef enum { COMP_COORD, SYM_COORD, SYMCOMP_COORD } CoordType;
 typedef struct {
 	int n;
@@ -14,15 +20,31 @@ typedef struct coordinate {
 	char *name;
 	CoordType type;
 	coord_value_t max;
-	coord_value_t *mtable[NMOVES_HTM];
-	coord_value_t *ttable[NTRANS];
+	/*
+	 * The move of ind by m is mtable[m][ind * mstride]. If indexmajor
+	 * is set the rows are interleaved in a single table, so that all
+	 * the moves of an index are next to each other, and mstride is
+	 * NMOVES_HTM; otherwise it is 1. The same holds for ttrep_move.
+	 * The layout is recorded in the tables file, and the one found
+	 * there is used when they are loaded.
+	 */
+	bool indexmajor;
+	coord_value_t mstride;
+	/*
+	 * The entries of mtable, ttable and symclass take width bytes: 2 if
+	 * max fits in 16 bits, 4 otherwise. They are accessed with tableval()
+	 * and tableset(). Transformations always take 1 byte.
+	 */
+	uint8_t width;
+	void *mtable[NMOVES_HTM];
+	void *ttable[NTRANS];
 	TransGroup *tgrp;
 	struct coordinate *base[2];
 
-	coord_value_t *symclass;
+	void *symclass;
 	coord_value_t *symrep;
-	Trans *transtorep;
-	Trans *ttrep_move[NMOVES_HTM];
+	uint8_t *transtorep;
+	uint8_t *ttrep_move[NMOVES_HTM];
 
 	bool generated;
 	Indexer *i[99];
@@ -33,6 +55,7 @@ typedef struct coordinate {
 	entry_group_t *ptable;
 	int8_t ptablebase;
 	bool compact;
+	bool mod3;
 	coord_value_t count[16];
 } Coordinate;
 
@@ -40,6 +63,10 @@ coord_value_t indexers_getind(Indexer **, Cube *);
 coord_value_t indexers_getmax(Indexer **);
 void indexers_makecube(Indexer **, coord_value_t, Cube *);
 
+void set_width(Coordinate *);
+coord_value_t tableval(Coordinate *, void *, coord_value_t);
+void tableset(Coordinate *, void *, coord_value_t, coord_value_t);
+
 void alloc_sd(Coordinate *, bool);
 void alloc_mtable(Coordinate *);
 void alloc_ttrep_move(Coordinate *);
@@ -51,8 +78,14 @@ coord_value_t move_coord(Coordinate *, Move, coord_value_t, Trans *);
 coord_value_t trans_coord(Coordinate *, Trans, coord_value_t);
 
 int ptableval(Coordinate *, coord_value_t);
+int ptabledist(Coordinate *, coord_value_t);
+int ptableneighbor(Coordinate *, coord_value_t, int);
+bool ptablefallback(Coordinate *, coord_value_t);
+void ptableprefetch(Coordinate *, coord_value_t);
 size_t ptablesize(Coordinate *);
-void ptableupdate(Coordinate *, coord_value_t, int);
 
-size_t read_coord(Coordinate *, char *);
-size_t write_coord(Coordinate *, char *);
+bool read_tables(Coordinate *[], char *, size_t);
+bool read_tables_stream(Coordinate *[], TablesIO *, void *);
+bool map_tables(Coordinate *[], char *, size_t);
+size_t write_tables(Coordinate *[], TablesIO *, void *);
+void free_tables(Coordinate *[]);
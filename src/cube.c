@@ -1,17 +1,37 @@
+#include <inttypes.h>
 #include <stdbool.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
 
 #include "cube.h"
 
-static void apply_permutation(int *, int *, int, int *);
-static void sum_arrays_mod(int *, int *, int, int);
+/* Only used to write down cubes in a readable way */
+typedef struct { int ep[12]; int eo[12]; int cp[8]; int co[8]; } CubeArray;
+
+static void pack_cube(const CubeArray *, Cube *);
+static void mirror_co(Cube *);
 static Move read_move(char *, int *);
-static void init_moves(void);
-static void init_trans(void);
+static bool scramble_cube(const Cube *, char *, Cube *);
+static void trans_cube(const Cube *, const Cube *, Trans, Cube *);
+static void gen_moves(CubeData *);
+static void gen_trans(CubeData *);
+
+static const Cube solved_cube = {
+	.edge   = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	.corner = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+};
 
-static Cube move_array[NMOVES_ALL];
-Move moves_ttable[NTRANS][NMOVES_ALL];
-Trans trans_ttable[NTRANS][NTRANS];
-Trans trans_itable[NTRANS];
+/*
+ * move_array, trans_pre, trans_post, moves_ttable, trans_ttable and
+ * trans_itable, as static constants. They are generated by gen_cube()
+ * and written out by build/gencube.c, see "make cubedata".
+ */
+#include "cubedata.h"
 
 static char move_string[NMOVES_ALL][7] = {
 	[NULLMOVE] = "-",
@@ -43,6 +63,27 @@ static char rotation_string[100][NTRANS/2] = {
 	[bu] = "x3",   [br] = "x3 y", [bd] = "x3 y2", [bl] = "x3 y3",
 };
 
+static char trans_string[NTRANS][10] = {
+	[uf] = "uf", [ur] = "ur", [ub] = "ub", [ul] = "ul",
+	[df] = "df", [dr] = "dr", [db] = "db", [dl] = "dl",
+	[rf] = "rf", [rd] = "rd", [rb] = "rb", [ru] = "ru",
+	[lf] = "lf", [ld] = "ld", [lb] = "lb", [lu] = "lu",
+	[fu] = "fu", [fr] = "fr", [fd] = "fd", [fl] = "fl",
+	[bu] = "bu", [br] = "br", [bd] = "bd", [bl] = "bl",
+	[uf_mirror] = "uf_mirror", [ur_mirror] = "ur_mirror",
+	[ub_mirror] = "ub_mirror", [ul_mirror] = "ul_mirror",
+	[df_mirror] = "df_mirror", [dr_mirror] = "dr_mirror",
+	[db_mirror] = "db_mirror", [dl_mirror] = "dl_mirror",
+	[rf_mirror] = "rf_mirror", [rd_mirror] = "rd_mirror",
+	[rb_mirror] = "rb_mirror", [ru_mirror] = "ru_mirror",
+	[lf_mirror] = "lf_mirror", [ld_mirror] = "ld_mirror",
+	[lb_mirror] = "lb_mirror", [lu_mirror] = "lu_mirror",
+	[fu_mirror] = "fu_mirror", [fr_mirror] = "fr_mirror",
+	[fd_mirror] = "fd_mirror", [fl_mirror] = "fl_mirror",
+	[bu_mirror] = "bu_mirror", [br_mirror] = "br_mirror",
+	[bd_mirror] = "bd_mirror", [bl_mirror] = "bl_mirror",
+};
+
 TransGroup
 tgrp_udfix = {
 	.n = 16,
@@ -55,106 +96,250 @@ tgrp_udfix = {
 };
 
 static void
-apply_permutation(int *perm, int *set, int n, int *aux)
+pack_cube(const CubeArray *a, Cube *cube)
 {
 	int i;
 
-	for (i = 0; i < n; i++)
-		aux[i] = set[perm[i]];
-
-	for (i = 0; i < n; i++)
-		set[i] = aux[i];
+	make_solved(cube);
+	for (i = 0; i < 12; i++)
+		cube->edge[i] = a->ep[i] | (a->eo[i] << EOSHIFT);
+	for (i = 0; i < 8; i++)
+		cube->corner[i] = a->cp[i] | (a->co[i] << COSHIFT);
 }
 
+/* Corner orientation 1 becomes 2 and vice versa */
 static void
-sum_arrays_mod(int *src, int *dst, int n, int m)
+mirror_co(Cube *cube)
 {
 	int i;
+	uint8_t c;
 
-	for (i = 0; i < n; i++)
-		dst[i] = (src[i] + dst[i]) % m;
+	for (i = 0; i < 8; i++) {
+		c = cube->corner[i];
+		cube->corner[i] = (c & ~COBITS) | (((c << 1) | (c >> 1)) & COBITS);
+	}
 }
 
+#if defined(__AVX2__)
+
+/*
+ * Shuffles work inside each 128-bit lane, so edges and corners are composed
+ * at the same time. Edge orientations are summed with a xor. Corner
+ * orientations are summed as bytes, then reduced mod 3 (in units of
+ * 1 << COSHIFT) by taking the minimum of x and x - 3, which wraps around.
+ */
 void
-compose(Cube *c2, Cube *c1)
+compose(const Cube *c2, Cube *c1)
 {
-	int aux[12];
+	__m256i a, b, s, p, eo, co;
 
-	apply_permutation(c2->ep, c1->ep, 12, aux);
-	apply_permutation(c2->ep, c1->eo, 12, aux);
-	sum_arrays_mod(c2->eo, c1->eo, 12, 2);
+	a = _mm256_loadu_si256((__m256i *)c1);
+	b = _mm256_loadu_si256((const __m256i *)c2);
 
-	apply_permutation(c2->cp, c1->cp, 8, aux);
-	apply_permutation(c2->cp, c1->co, 8, aux);
+	s = _mm256_shuffle_epi8(a, _mm256_and_si256(b, _mm256_set1_epi8(PBITS)));
+	p = _mm256_and_si256(s, _mm256_set1_epi8(PBITS));
+	eo = _mm256_and_si256(_mm256_xor_si256(s, b), _mm256_set1_epi8(EOBIT));
+	co = _mm256_add_epi8(_mm256_and_si256(s, _mm256_set1_epi8(COBITS)),
+	    _mm256_and_si256(b, _mm256_set1_epi8(COBITS)));
+	co = _mm256_min_epu8(co,
+	    _mm256_sub_epi8(co, _mm256_set1_epi8(3 << COSHIFT)));
 
-	sum_arrays_mod(c2->co, c1->co, 8, 3);
+	_mm256_storeu_si256((__m256i *)c1,
+	    _mm256_or_si256(p, _mm256_or_si256(eo, co)));
 }
 
+/*
+ * For every i, the element in position i is broadcast and compared with
+ * all positions: the position equal to its piece gets i and its
+ * orientation. Corner orientations are then inverted.
+ */
 void
-copy_cube(Cube *src, Cube *dst)
+invert_cube(Cube *cube)
+{
+	int i;
+	__m256i a, id, pi, eq, ori, inv, co, m;
+
+	a = _mm256_loadu_si256((__m256i *)cube);
+	id = _mm256_loadu_si256((__m256i *)&solved_cube);
+	ori = _mm256_set1_epi8(EOBIT | COBITS);
+	inv = _mm256_setzero_si256();
+	for (i = 0; i < 16; i++) {
+		pi = _mm256_shuffle_epi8(a, _mm256_set1_epi8(i));
+		eq = _mm256_cmpeq_epi8(
+		    _mm256_and_si256(pi, _mm256_set1_epi8(PBITS)), id);
+		pi = _mm256_or_si256(_mm256_and_si256(pi, ori),
+		    _mm256_set1_epi8(i));
+		inv = _mm256_or_si256(inv, _mm256_and_si256(eq, pi));
+	}
+
+	/* Corners are in the high lane */
+	m = _mm256_set_m128i(_mm_set1_epi8(COBITS), _mm_setzero_si128());
+	co = _mm256_and_si256(m, _mm256_or_si256(
+	    _mm256_slli_epi16(inv, 1), _mm256_srli_epi16(inv, 1)));
+	inv = _mm256_or_si256(co, _mm256_andnot_si256(m, inv));
+
+	_mm256_storeu_si256((__m256i *)cube, inv);
+}
+
+bool
+is_solved(Cube *cube)
+{
+	__m256i a, b;
+
+	a = _mm256_loadu_si256((__m256i *)cube);
+	b = _mm256_loadu_si256((__m256i *)&solved_cube);
+
+	return _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) == -1;
+}
+
+#elif defined(__SSSE3__)
+
+/* Same as the AVX2 version, but on edges and corners separately */
+static __m128i
+compose128(__m128i b, __m128i a)
+{
+	__m128i s, p, eo, co;
+
+	s = _mm_shuffle_epi8(a, _mm_and_si128(b, _mm_set1_epi8(PBITS)));
+	p = _mm_and_si128(s, _mm_set1_epi8(PBITS));
+	eo = _mm_and_si128(_mm_xor_si128(s, b), _mm_set1_epi8(EOBIT));
+	co = _mm_add_epi8(_mm_and_si128(s, _mm_set1_epi8(COBITS)),
+	    _mm_and_si128(b, _mm_set1_epi8(COBITS)));
+	co = _mm_min_epu8(co, _mm_sub_epi8(co, _mm_set1_epi8(3 << COSHIFT)));
+
+	return _mm_or_si128(p, _mm_or_si128(eo, co));
+}
+
+static __m128i
+invert128(__m128i a)
 {
 	int i;
+	__m128i id, pi, eq, ori, inv;
+
+	id = _mm_loadu_si128((__m128i *)solved_cube.edge);
+	ori = _mm_set1_epi8(EOBIT | COBITS);
+	inv = _mm_setzero_si128();
+	for (i = 0; i < 16; i++) {
+		pi = _mm_shuffle_epi8(a, _mm_set1_epi8(i));
+		eq = _mm_cmpeq_epi8(_mm_and_si128(pi, _mm_set1_epi8(PBITS)), id);
+		pi = _mm_or_si128(_mm_and_si128(pi, ori), _mm_set1_epi8(i));
+		inv = _mm_or_si128(inv, _mm_and_si128(eq, pi));
+	}
+
+	return inv;
+}
+
+void
+compose(const Cube *c2, Cube *c1)
+{
+	__m128i e, c;
+
+	e = compose128(_mm_loadu_si128((const __m128i *)c2->edge),
+	    _mm_loadu_si128((__m128i *)c1->edge));
+	c = compose128(_mm_loadu_si128((const __m128i *)c2->corner),
+	    _mm_loadu_si128((__m128i *)c1->corner));
+
+	_mm_storeu_si128((__m128i *)c1->edge, e);
+	_mm_storeu_si128((__m128i *)c1->corner, c);
+}
+
+void
+invert_cube(Cube *cube)
+{
+	__m128i e, c, co;
+
+	e = invert128(_mm_loadu_si128((__m128i *)cube->edge));
+	c = invert128(_mm_loadu_si128((__m128i *)cube->corner));
+
+	co = _mm_and_si128(_mm_set1_epi8(COBITS),
+	    _mm_or_si128(_mm_slli_epi16(c, 1), _mm_srli_epi16(c, 1)));
+	c = _mm_or_si128(co, _mm_andnot_si128(_mm_set1_epi8(COBITS), c));
+
+	_mm_storeu_si128((__m128i *)cube->edge, e);
+	_mm_storeu_si128((__m128i *)cube->corner, c);
+}
+
+bool
+is_solved(Cube *cube)
+{
+	__m128i e, c;
+
+	e = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i *)cube->edge),
+	    _mm_loadu_si128((__m128i *)solved_cube.edge));
+	c = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i *)cube->corner),
+	    _mm_loadu_si128((__m128i *)solved_cube.corner));
+
+	return _mm_movemask_epi8(_mm_and_si128(e, c)) == 0xFFFF;
+}
+
+#else
+
+void
+compose(const Cube *c2, Cube *c1)
+{
+	int i, co;
+	uint8_t p, x;
+	Cube aux;
+
+	aux = *c1;
 
 	for (i = 0; i < 12; i++) {
-		dst->ep[i] = src->ep[i];
-		dst->eo[i] = src->eo[i];
+		p = c2->edge[i];
+		x = c1->edge[p & PBITS];
+		aux.edge[i] = x ^ (p & EOBIT);
 	}
 
 	for (i = 0; i < 8; i++) {
-		dst->cp[i] = src->cp[i];
-		dst->co[i] = src->co[i];
+		p = c2->corner[i];
+		x = c1->corner[p & PBITS];
+		co = ((x & COBITS) >> COSHIFT) + ((p & COBITS) >> COSHIFT);
+		if (co >= 3)
+			co -= 3;
+		aux.corner[i] = (x & PBITS) | (co << COSHIFT);
 	}
+
+	*c1 = aux;
 }
 
 void
 invert_cube(Cube *cube)
 {
+	int i, co;
+	uint8_t x;
 	Cube aux;
-	int i;
 
-	copy_cube(cube, &aux);
+	aux = *cube;
 
 	for (i = 0; i < 12; i++) {
-		cube->ep[aux.ep[i]] = i;
-		cube->eo[aux.ep[i]] = aux.eo[i];
+		x = aux.edge[i];
+		cube->edge[x & PBITS] = i | (x & EOBIT);
 	}
 
 	for (i = 0; i < 8; i++) {
-		cube->cp[aux.cp[i]] = i;
-		cube->co[aux.cp[i]] = (3 - aux.co[i]) % 3;
+		x = aux.corner[i];
+		co = (x & COBITS) >> COSHIFT;
+		cube->corner[x & PBITS] = i | (((3 - co) % 3) << COSHIFT);
 	}
 }
 
 bool
 is_solved(Cube *cube)
 {
-	int i;
+	return !memcmp(cube, &solved_cube, sizeof(Cube));
+}
 
-	for (i = 0; i < 12; i++)
-		if (cube->eo[i] != 0 || cube->ep[i] != i)
-			return false;
+#endif
 
-	for (i = 0; i < 8; i++)
-		if (cube->co[i] != 0 || cube->cp[i] != i)
-			return false;
-
-	return true;
+void
+copy_cube(const Cube *src, Cube *dst)
+{
+	*dst = *src;
 }
 
 void
 make_solved(Cube *cube)
 {
-	int i;
-
-	for (i = 0; i < 12; i++) {
-		cube->ep[i] = i;
-		cube->eo[i] = 0;
-	}
-
-	for (i = 0; i < 8; i++) {
-		cube->cp[i] = i;
-		cube->co[i] = 0;
-	}
+	*cube = solved_cube;
 }
 
 Move
@@ -261,8 +446,9 @@ read_move(char *str, int *i)
 	return NULLMOVE;
 }
 
-bool 
-apply_scramble(char *str, Cube *c)
+/* Same as apply_scramble(), with the moves taken from move_array */
+static bool
+scramble_cube(const Cube *move_array, char *str, Cube *c)
 {
 	int i;
 	bool niss;
@@ -294,7 +480,7 @@ apply_scramble(char *str, Cube *c)
 		move = read_move(str, &i);
 		if (move == NULLMOVE)
 			return false;
-		apply_move(move, niss ? &inverse : &normal);
+		compose(&move_array[move], niss ? &inverse : &normal);
 	}
 
 	if (niss)
@@ -308,6 +494,12 @@ apply_scramble(char *str, Cube *c)
 	return true;
 }
 
+bool
+apply_scramble(char *str, Cube *c)
+{
+	return scramble_cube(move_array, str, c);
+}
+
 int
 alg_string(Alg *alg, char *str)
 {
@@ -342,36 +534,53 @@ alg_string(Alg *alg, char *str)
 	return n;
 }
 
-void
-apply_trans(Trans t, Cube *cube)
+/* Reads the name of a transformation, for example "uf" */
+bool
+read_trans(char *str, Trans *t)
 {
-	Cube aux, inv;
-	int i;
+	Trans i;
 
-	static Cube mirror_cube = {
-	.ep = { [UF] = UF, [UL] = UR, [UB] = UB, [UR] = UL,
-		[DF] = DF, [DL] = DR, [DB] = DB, [DR] = DL,
-		[FR] = FL, [FL] = FR, [BL] = BR, [BR] = BL },
-	.cp = { [UFR] = UFL, [UFL] = UFR, [UBL] = UBR, [UBR] = UBL,
-		[DFR] = DFL, [DFL] = DFR, [DBL] = DBR, [DBR] = DBL },
-	};
+	for (i = 0; i < NTRANS; i++) {
+		if (!strcmp(str, trans_string[i])) {
+			*t = i;
+			return true;
+		}
+	}
 
-	copy_cube(cube, &aux);
-	make_solved(cube);
+	return false;
+}
 
-	if (t >= NTRANS/2)
-		compose(&mirror_cube, cube);
-	make_solved(&inv);
-	apply_scramble(rotation_string[t % (NTRANS/2)], &inv);
-	invert_cube(&inv);
-	compose(&inv, cube);
+char *
+trans_name(Trans t)
+{
+	return trans_string[t];
+}
+
+/* Same as apply_trans(), with the given trans_pre and trans_post */
+static void
+trans_cube(const Cube *trans_pre, const Cube *trans_post, Trans t,
+    Cube *cube)
+{
+	Cube aux;
+
+	copy_cube(cube, &aux);
+	copy_cube(&trans_pre[t], cube);
 	compose(&aux, cube);
-	apply_scramble(rotation_string[t % (NTRANS/2)], cube);
-	if (t >= NTRANS/2) {
-		compose(&mirror_cube, cube);
-		for (i = 0; i < 8; i++)
-			cube->co[i] = (3 - cube->co[i]) % 3;
-	}
+	compose(&trans_post[t], cube);
+	if (t >= NTRANS/2)
+		mirror_co(cube);
+}
+
+/*
+ * A transformation is a conjugation: the cube is composed between
+ * trans_pre[t] (mirror, then inverse rotation) and trans_post[t]
+ * (rotation, then mirror). Mirrored transformations also swap the
+ * corner twists.
+ */
+void
+apply_trans(Trans t, Cube *cube)
+{
+	trans_cube(trans_pre, trans_post, t, cube);
 }
 
 Trans
@@ -402,7 +611,8 @@ transform_trans(Trans t, Trans m)
 }
 
 static void
-init_moves(void) {
+gen_moves(CubeData *d)
+{
 	Move m;
 
 	/* Moves are represented as cubes and applied using compose().
@@ -470,12 +680,12 @@ init_moves(void) {
 		[z3]  = "  y    x    yyy  "
 	};
 
-	const Cube mcu = {
+	const CubeArray mcu = {
 		.ep = { UR, UF, UL, UB, DF, DL, DB, DR, FR, FL, BL, BR },
 		.cp = { UBR, UFR, UFL, UBL, DFR, DFL, DBL, DBR },
 	};
 
-	const Cube mcx = {
+	const CubeArray mcx = {
 		.ep = { DF, FL, UF, FR, DB, BL, UB, BR, DR, DL, UL, UR },
 		.eo = { [UF] = 1, [UB] = 1, [DF] = 1, [DB] = 1 },
 		.cp = { DFR, DFL, UFL, UFR, DBR, DBL, UBL, UBR },
@@ -483,49 +693,76 @@ init_moves(void) {
 			[DBR] = 2, [DFR] = 1, [DBL] = 1, [DFL] = 2 },
 	};
 
-	const Cube mcy = {
+	const CubeArray mcy = {
 		.ep = { UR, UF, UL, UB, DR, DF, DL, DB, BR, FR, FL, BL },
 		.eo = { [FR] = 1, [FL] = 1, [BL] = 1, [BR] = 1 },
 		.cp = { UBR, UFR, UFL, UBL, DBR, DFR, DFL, DBL },
 	};
 
-	move_array[U] = mcu;
-	move_array[x] = mcx;
-	move_array[y] = mcy;
+	const CubeArray mirror = {
+		.ep = { [UF] = UF, [UL] = UR, [UB] = UB, [UR] = UL,
+			[DF] = DF, [DL] = DR, [DB] = DB, [DR] = DL,
+			[FR] = FL, [FL] = FR, [BL] = BR, [BR] = BL },
+		.cp = { [UFR] = UFL, [UFL] = UFR, [UBL] = UBR, [UBR] = UBL,
+			[DFR] = DFL, [DFL] = DFR, [DBL] = DBR, [DBR] = DBL },
+	};
+
+	pack_cube(&mcu, &d->move_array[U]);
+	pack_cube(&mcx, &d->move_array[x]);
+	pack_cube(&mcy, &d->move_array[y]);
+	pack_cube(&mirror, &d->mirror_cube);
 
 	for (m = 0; m < NMOVES_ALL; m++) {
 		switch (m) {
 		case NULLMOVE:
-			make_solved(&move_array[m]);
+			make_solved(&d->move_array[m]);
 			break;
 		case U:
 		case x:
 		case y:
 			break;
 		default:
-			make_solved(&move_array[m]);
-			apply_scramble(equiv_alg_string[m], &move_array[m]);
+			make_solved(&d->move_array[m]);
+			scramble_cube(d->move_array, equiv_alg_string[m],
+			    &d->move_array[m]);
 			break;
 		}
 	}
 }
 
 static void
-init_trans(void) {
+gen_trans(CubeData *d)
+{
 	Cube aux, cube;
 	Move mi, move;
 	Trans t, u, v;
 
+	for (t = 0; t < NTRANS; t++) {
+		make_solved(&d->trans_pre[t]);
+		make_solved(&d->trans_post[t]);
+		if (t >= NTRANS/2)
+			compose(&d->mirror_cube, &d->trans_pre[t]);
+		make_solved(&aux);
+		scramble_cube(d->move_array,
+		    rotation_string[t % (NTRANS/2)], &aux);
+		invert_cube(&aux);
+		compose(&aux, &d->trans_pre[t]);
+		scramble_cube(d->move_array,
+		    rotation_string[t % (NTRANS/2)], &d->trans_post[t]);
+		if (t >= NTRANS/2)
+			compose(&d->mirror_cube, &d->trans_post[t]);
+	}
+
 	for (t = 0; t < NTRANS; t++) {
 		for (mi = 0; mi < NMOVES_ALL; mi++) {
 			make_solved(&aux);
-			apply_move(mi, &aux);
-			apply_trans(t, &aux);
+			compose(&d->move_array[mi], &aux);
+			trans_cube(d->trans_pre, d->trans_post, t, &aux);
 			for (move = 0; move < NMOVES_ALL; move++) {
 				copy_cube(&aux, &cube);
-				apply_move(inverse_move(move), &cube);
+				compose(&d->move_array[inverse_move(move)], &cube);
 				if (is_solved(&cube)) {
-					moves_ttable[t][mi] = move;
+					d->moves_ttable[t][mi] = move;
 					break;
 				}
 			}
@@ -535,19 +772,19 @@ init_trans(void) {
 	for (t = 0; t < NTRANS; t++) {
 		for (u = 0; u < NTRANS; u++) {
 			make_solved(&aux);
-			apply_scramble("R' U' F", &aux);
-			apply_trans(u, &aux);
-			apply_trans(t, &aux);
+			scramble_cube(d->move_array, "R' U' F", &aux);
+			trans_cube(d->trans_pre, d->trans_post, u, &aux);
+			trans_cube(d->trans_pre, d->trans_post, t, &aux);
 			for (v = 0; v < NTRANS; v++) {
 				copy_cube(&aux, &cube);
-				apply_trans(v, &cube);
-				apply_scramble("F' U R", &cube);
+				trans_cube(d->trans_pre, d->trans_post, v, &cube);
+				scramble_cube(d->move_array, "F' U R", &cube);
 				if (is_solved(&cube)) {
 					/* This is the inverse of the correct
 					   value, it will be inverted later */
-					trans_ttable[t][u] = v;
+					d->trans_ttable[t][u] = v;
 					if (v == uf)
-						trans_itable[t] = u;
+						d->trans_itable[t] = u;
 					break;
 				}
 			}
@@ -555,12 +792,38 @@ init_trans(void) {
 	}
 	for (t = 0; t < NTRANS; t++)
 		for (u = 0; u < NTRANS; u++)
-			trans_ttable[t][u] = trans_itable[trans_ttable[t][u]];
+			d->trans_ttable[t][u] =
+			    d->trans_itable[d->trans_ttable[t][u]];
+}
+
+/*
+ * The tables are computed from scratch in d, without using the constant
+ * ones, so that these can be checked against them.
+ */
+void
+gen_cube(CubeData *d)
+{
+	gen_moves(d);
+	gen_trans(d);
+}
+
+bool
+check_cube(void)
+{
+	static CubeData d;
+
+	gen_cube(&d);
+
+	return !memcmp(d.move_array, move_array, sizeof(move_array)) &&
+	    !memcmp(d.trans_pre, trans_pre, sizeof(trans_pre)) &&
+	    !memcmp(d.trans_post, trans_post, sizeof(trans_post)) &&
+	    !memcmp(d.moves_ttable, moves_ttable, sizeof(moves_ttable)) &&
+	    !memcmp(d.trans_ttable, trans_ttable, sizeof(trans_ttable)) &&
+	    !memcmp(d.trans_itable, trans_itable, sizeof(trans_itable));
 }
 
+/* All the tables are in cubedata.h, nothing to do */
 void
 init_cube(void)
 {
-	init_moves();
-	init_trans();
 }
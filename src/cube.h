@@ -33,14 +33,47 @@ typedef enum {
         bu_mirror, br_mirror, bd_mirror, bl_mirror,
 } Trans;
 
-typedef struct { int ep[12]; int eo[12]; int cp[8]; int co[8]; } Cube;
+/*
+ * A cube is stored as 16 bytes for the edges and 16 bytes for the corners,
+ * so that each group fits in a 128-bit register. Byte i contains the piece
+ * in position i in the lowest 4 bits, and its orientation in bit 4 (edges)
+ * or bits 5-6 (corners). Edge bytes 12-15 and corner bytes 8-15 are
+ * padding, and they are always the solved piece with orientation 0.
+ */
+#define PBITS   0x0F
+#define EOBIT   0x10
+#define EOSHIFT 4
+#define COBITS  0x60
+#define COSHIFT 5
+
+#define EP(c, i)        ((c)->edge[i] & PBITS)
+#define EO(c, i)        (((c)->edge[i] & EOBIT) >> EOSHIFT)
+#define CP(c, i)        ((c)->corner[i] & PBITS)
+#define CO(c, i)        (((c)->corner[i] & COBITS) >> COSHIFT)
+#define SET_EP(c, i, p) ((c)->edge[i] = ((c)->edge[i] & ~PBITS) | (p))
+#define SET_EO(c, i, o) ((c)->edge[i] = EP(c, i) | ((o) << EOSHIFT))
+#define SET_CP(c, i, p) ((c)->corner[i] = ((c)->corner[i] & ~PBITS) | (p))
+#define SET_CO(c, i, o) ((c)->corner[i] = CP(c, i) | ((o) << COSHIFT))
+
+typedef struct { uint8_t edge[16]; uint8_t corner[16]; } Cube;
 typedef struct { Move move[MAX_ALG_LEN]; bool inv[MAX_ALG_LEN]; int len; } Alg;
 typedef struct { int n; Trans t[NTRANS]; } TransGroup;
 
+/* The tables computed by gen_cube(), see src/cubedata.h */
+typedef struct {
+	Cube move_array[NMOVES_ALL];
+	Cube mirror_cube;
+	Cube trans_pre[NTRANS];
+	Cube trans_post[NTRANS];
+	Move moves_ttable[NTRANS][NMOVES_ALL];
+	Trans trans_ttable[NTRANS][NTRANS];
+	Trans trans_itable[NTRANS];
+} CubeData;
+
 extern TransGroup tgrp_udfix;
 
-void compose(Cube *, Cube *);
-void copy_cube(Cube *, Cube *);
+void compose(const Cube *, Cube *);
+void copy_cube(const Cube *, Cube *);
 void invert_cube(Cube *);
 bool is_solved(Cube *);
 void make_solved(Cube *);
@@ -56,10 +89,14 @@ void apply_alg(Alg *, Cube *);
 bool apply_scramble(char *, Cube *);
 int alg_string(Alg *, char *);
 
+bool read_trans(char *, Trans *);
+char *trans_name(Trans);
 void apply_trans(Trans, Cube *);
 Trans inverse_trans(Trans);
 void transform_alg(Trans, Alg *);
 Move transform_move(Trans, Move);
 Trans transform_trans(Trans, Trans);
 
+void gen_cube(CubeData *);
+bool check_cube(void);
 void init_cube(void);
@@ -0,0 +1,1154 @@
+/* Generated by build/gencube.c, do not edit */
+
+static const Cube move_array[55] = {
+	{
+		.edge   = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 3, 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 3, 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 2, 3, 0, 1, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 2, 3, 0, 1, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 1, 2, 3, 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 1, 2, 3, 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 2, 3, 5, 6, 7, 4, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 5, 6, 7, 4, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 2, 3, 6, 7, 4, 5, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 6, 7, 4, 5, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 2, 3, 7, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 7, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 2, 8, 4, 5, 6, 11, 7, 9, 10, 3, 12, 13, 14, 15 },
+		.corner = { 68, 1, 2, 32, 39, 5, 6, 67, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 2, 7, 4, 5, 6, 3, 11, 9, 10, 8, 12, 13, 14, 15 },
+		.corner = { 7, 1, 2, 4, 3, 5, 6, 0, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 2, 11, 4, 5, 6, 8, 3, 9, 10, 7, 12, 13, 14, 15 },
+		.corner = { 67, 1, 2, 39, 32, 5, 6, 68, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 10, 2, 3, 4, 9, 6, 7, 8, 1, 5, 11, 12, 13, 14, 15 },
+		.corner = { 0, 34, 70, 3, 4, 65, 37, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 5, 2, 3, 4, 1, 6, 7, 8, 10, 9, 11, 12, 13, 14, 15 },
+		.corner = { 0, 6, 5, 3, 4, 2, 1, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 9, 2, 3, 4, 10, 6, 7, 8, 5, 1, 11, 12, 13, 14, 15 },
+		.corner = { 0, 37, 65, 3, 4, 70, 34, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 25, 1, 2, 3, 24, 5, 6, 7, 16, 20, 10, 11, 12, 13, 14, 15 },
+		.corner = { 33, 69, 2, 3, 64, 36, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 4, 1, 2, 3, 0, 5, 6, 7, 9, 8, 10, 11, 12, 13, 14, 15 },
+		.corner = { 5, 4, 2, 3, 1, 0, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 24, 1, 2, 3, 25, 5, 6, 7, 20, 16, 10, 11, 12, 13, 14, 15 },
+		.corner = { 36, 64, 2, 3, 69, 33, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 27, 3, 4, 5, 26, 7, 8, 9, 18, 22, 12, 13, 14, 15 },
+		.corner = { 0, 1, 35, 71, 4, 5, 66, 38, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 6, 3, 4, 5, 2, 7, 8, 9, 11, 10, 12, 13, 14, 15 },
+		.corner = { 0, 1, 7, 6, 4, 5, 3, 2, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 26, 3, 4, 5, 27, 7, 8, 9, 22, 18, 12, 13, 14, 15 },
+		.corner = { 0, 1, 38, 66, 4, 5, 71, 35, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 3, 0, 1, 2, 4, 5, 6, 7, 27, 24, 25, 26, 12, 13, 14, 15 },
+		.corner = { 3, 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 2, 3, 0, 1, 4, 5, 6, 7, 10, 11, 8, 9, 12, 13, 14, 15 },
+		.corner = { 2, 3, 0, 1, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 1, 2, 3, 0, 4, 5, 6, 7, 25, 26, 27, 24, 12, 13, 14, 15 },
+		.corner = { 1, 2, 3, 0, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 2, 3, 5, 6, 7, 4, 25, 26, 27, 24, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 5, 6, 7, 4, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 2, 3, 6, 7, 4, 5, 10, 11, 8, 9, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 6, 7, 4, 5, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 2, 3, 7, 4, 5, 6, 27, 24, 25, 26, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 7, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 20, 1, 16, 8, 22, 5, 18, 11, 7, 9, 10, 3, 12, 13, 14, 15 },
+		.corner = { 68, 1, 2, 32, 39, 5, 6, 67, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 6, 1, 4, 7, 2, 5, 0, 3, 11, 9, 10, 8, 12, 13, 14, 15 },
+		.corner = { 7, 1, 2, 4, 3, 5, 6, 0, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 18, 1, 22, 11, 16, 5, 20, 8, 3, 9, 10, 7, 12, 13, 14, 15 },
+		.corner = { 67, 1, 2, 39, 32, 5, 6, 68, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 18, 10, 22, 3, 16, 9, 20, 7, 8, 1, 5, 11, 12, 13, 14, 15 },
+		.corner = { 0, 34, 70, 3, 4, 65, 37, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 6, 5, 4, 3, 2, 1, 0, 7, 8, 10, 9, 11, 12, 13, 14, 15 },
+		.corner = { 0, 6, 5, 3, 4, 2, 1, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 20, 9, 16, 3, 22, 10, 18, 7, 8, 5, 1, 11, 12, 13, 14, 15 },
+		.corner = { 0, 37, 65, 3, 4, 70, 34, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 25, 21, 2, 17, 24, 23, 6, 19, 16, 20, 10, 11, 12, 13, 14, 15 },
+		.corner = { 33, 69, 2, 3, 64, 36, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 4, 7, 2, 5, 0, 3, 6, 1, 9, 8, 10, 11, 12, 13, 14, 15 },
+		.corner = { 5, 4, 2, 3, 1, 0, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 24, 19, 2, 23, 25, 17, 6, 21, 20, 16, 10, 11, 12, 13, 14, 15 },
+		.corner = { 36, 64, 2, 3, 69, 33, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 19, 27, 23, 4, 17, 26, 21, 8, 9, 18, 22, 12, 13, 14, 15 },
+		.corner = { 0, 1, 35, 71, 4, 5, 66, 38, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 7, 6, 5, 4, 3, 2, 1, 8, 9, 11, 10, 12, 13, 14, 15 },
+		.corner = { 0, 1, 7, 6, 4, 5, 3, 2, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 21, 26, 17, 4, 23, 27, 19, 8, 9, 22, 18, 12, 13, 14, 15 },
+		.corner = { 0, 1, 38, 66, 4, 5, 71, 35, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 18, 1, 22, 3, 16, 5, 20, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 6, 1, 4, 3, 2, 5, 0, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 20, 1, 16, 3, 22, 5, 18, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 21, 2, 17, 4, 23, 6, 19, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 7, 2, 5, 4, 3, 6, 1, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 19, 2, 23, 4, 17, 6, 21, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 2, 3, 4, 5, 6, 7, 25, 26, 27, 24, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 2, 3, 4, 5, 6, 7, 10, 11, 8, 9, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 1, 2, 3, 4, 5, 6, 7, 27, 24, 25, 26, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 20, 9, 16, 8, 22, 10, 18, 11, 7, 5, 1, 3, 12, 13, 14, 15 },
+		.corner = { 68, 37, 65, 32, 39, 70, 34, 67, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 6, 5, 4, 7, 2, 1, 0, 3, 11, 10, 9, 8, 12, 13, 14, 15 },
+		.corner = { 7, 6, 5, 4, 3, 2, 1, 0, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 18, 10, 22, 11, 16, 9, 20, 8, 3, 1, 5, 7, 12, 13, 14, 15 },
+		.corner = { 67, 34, 70, 39, 32, 65, 37, 68, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 3, 0, 1, 2, 7, 4, 5, 6, 27, 24, 25, 26, 12, 13, 14, 15 },
+		.corner = { 3, 0, 1, 2, 7, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 12, 13, 14, 15 },
+		.corner = { 2, 3, 0, 1, 6, 7, 4, 5, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 1, 2, 3, 0, 5, 6, 7, 4, 25, 26, 27, 24, 12, 13, 14, 15 },
+		.corner = { 1, 2, 3, 0, 5, 6, 7, 4, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 25, 21, 26, 17, 24, 23, 27, 19, 16, 20, 22, 18, 12, 13, 14, 15 },
+		.corner = { 33, 69, 38, 66, 64, 36, 71, 35, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 4, 7, 6, 5, 0, 3, 2, 1, 9, 8, 11, 10, 12, 13, 14, 15 },
+		.corner = { 5, 4, 7, 6, 1, 0, 3, 2, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 24, 19, 27, 23, 25, 17, 26, 21, 20, 16, 18, 22, 12, 13, 14, 15 },
+		.corner = { 36, 64, 35, 71, 69, 33, 66, 38, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+};
+
+static const Cube trans_pre[48] = {
+	{
+		.edge   = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 1, 2, 3, 0, 5, 6, 7, 4, 25, 26, 27, 24, 12, 13, 14, 15 },
+		.corner = { 1, 2, 3, 0, 5, 6, 7, 4, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 12, 13, 14, 15 },
+		.corner = { 2, 3, 0, 1, 6, 7, 4, 5, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 3, 0, 1, 2, 7, 4, 5, 6, 27, 24, 25, 26, 12, 13, 14, 15 },
+		.corner = { 3, 0, 1, 2, 7, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 4, 7, 6, 5, 0, 3, 2, 1, 9, 8, 11, 10, 12, 13, 14, 15 },
+		.corner = { 5, 4, 7, 6, 1, 0, 3, 2, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 7, 6, 5, 4, 3, 2, 1, 0, 24, 27, 26, 25, 12, 13, 14, 15 },
+		.corner = { 4, 7, 6, 5, 0, 3, 2, 1, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 6, 5, 4, 7, 2, 1, 0, 3, 11, 10, 9, 8, 12, 13, 14, 15 },
+		.corner = { 7, 6, 5, 4, 3, 2, 1, 0, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 5, 4, 7, 6, 1, 0, 3, 2, 26, 25, 24, 27, 12, 13, 14, 15 },
+		.corner = { 6, 5, 4, 7, 2, 1, 0, 3, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 25, 21, 26, 17, 24, 23, 27, 19, 16, 20, 22, 18, 12, 13, 14, 15 },
+		.corner = { 33, 69, 38, 66, 64, 36, 71, 35, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 10, 22, 11, 18, 9, 20, 8, 16, 17, 21, 23, 19, 12, 13, 14, 15 },
+		.corner = { 34, 70, 39, 67, 65, 37, 68, 32, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 27, 23, 24, 19, 26, 21, 25, 17, 18, 22, 20, 16, 12, 13, 14, 15 },
+		.corner = { 35, 71, 36, 64, 66, 38, 69, 33, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 8, 20, 9, 16, 11, 22, 10, 18, 19, 23, 21, 17, 12, 13, 14, 15 },
+		.corner = { 32, 68, 37, 65, 67, 39, 70, 34, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 24, 19, 27, 23, 25, 17, 26, 21, 20, 16, 18, 22, 12, 13, 14, 15 },
+		.corner = { 36, 64, 35, 71, 69, 33, 66, 38, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 11, 18, 10, 22, 8, 16, 9, 20, 23, 19, 17, 21, 12, 13, 14, 15 },
+		.corner = { 39, 67, 34, 70, 68, 32, 65, 37, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 26, 17, 25, 21, 27, 19, 24, 23, 22, 18, 16, 20, 12, 13, 14, 15 },
+		.corner = { 38, 66, 33, 69, 71, 35, 64, 36, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 9, 16, 8, 20, 10, 18, 11, 22, 21, 17, 19, 23, 12, 13, 14, 15 },
+		.corner = { 37, 65, 32, 68, 70, 34, 67, 39, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 16, 8, 20, 9, 18, 11, 22, 10, 1, 3, 7, 5, 12, 13, 14, 15 },
+		.corner = { 65, 32, 68, 37, 34, 67, 39, 70, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 19, 27, 23, 24, 17, 26, 21, 25, 0, 2, 6, 4, 12, 13, 14, 15 },
+		.corner = { 64, 35, 71, 36, 33, 66, 38, 69, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 18, 10, 22, 11, 16, 9, 20, 8, 3, 1, 5, 7, 12, 13, 14, 15 },
+		.corner = { 67, 34, 70, 39, 32, 65, 37, 68, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 17, 25, 21, 26, 19, 24, 23, 27, 2, 0, 4, 6, 12, 13, 14, 15 },
+		.corner = { 66, 33, 69, 38, 35, 64, 36, 71, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 20, 9, 16, 8, 22, 10, 18, 11, 7, 5, 1, 3, 12, 13, 14, 15 },
+		.corner = { 68, 37, 65, 32, 39, 70, 34, 67, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 21, 26, 17, 25, 23, 27, 19, 24, 4, 6, 2, 0, 12, 13, 14, 15 },
+		.corner = { 69, 38, 66, 33, 36, 71, 35, 64, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 22, 11, 18, 10, 20, 8, 16, 9, 5, 7, 3, 1, 12, 13, 14, 15 },
+		.corner = { 70, 39, 67, 34, 37, 68, 32, 65, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 23, 24, 19, 27, 21, 25, 17, 26, 6, 4, 0, 2, 12, 13, 14, 15 },
+		.corner = { 71, 36, 64, 35, 38, 69, 33, 66, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 3, 2, 1, 4, 7, 6, 5, 9, 8, 11, 10, 12, 13, 14, 15 },
+		.corner = { 1, 0, 3, 2, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 3, 2, 1, 0, 7, 6, 5, 4, 24, 27, 26, 25, 12, 13, 14, 15 },
+		.corner = { 0, 3, 2, 1, 4, 7, 6, 5, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 2, 1, 0, 3, 6, 5, 4, 7, 11, 10, 9, 8, 12, 13, 14, 15 },
+		.corner = { 3, 2, 1, 0, 7, 6, 5, 4, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 1, 0, 3, 2, 5, 4, 7, 6, 26, 25, 24, 27, 12, 13, 14, 15 },
+		.corner = { 2, 1, 0, 3, 6, 5, 4, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 4, 5, 6, 7, 0, 1, 2, 3, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 4, 5, 6, 7, 0, 1, 2, 3, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 5, 6, 7, 4, 1, 2, 3, 0, 25, 26, 27, 24, 12, 13, 14, 15 },
+		.corner = { 5, 6, 7, 4, 1, 2, 3, 0, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 6, 7, 4, 5, 2, 3, 0, 1, 10, 11, 8, 9, 12, 13, 14, 15 },
+		.corner = { 6, 7, 4, 5, 2, 3, 0, 1, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 7, 4, 5, 6, 3, 0, 1, 2, 27, 24, 25, 26, 12, 13, 14, 15 },
+		.corner = { 7, 4, 5, 6, 3, 0, 1, 2, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 24, 23, 27, 19, 25, 21, 26, 17, 16, 20, 22, 18, 12, 13, 14, 15 },
+		.corner = { 32, 68, 39, 67, 65, 37, 70, 34, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 11, 22, 10, 18, 8, 20, 9, 16, 19, 23, 21, 17, 12, 13, 14, 15 },
+		.corner = { 35, 71, 38, 66, 64, 36, 69, 33, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 26, 21, 25, 17, 27, 23, 24, 19, 18, 22, 20, 16, 12, 13, 14, 15 },
+		.corner = { 34, 70, 37, 65, 67, 39, 68, 32, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 9, 20, 8, 16, 10, 22, 11, 18, 17, 21, 23, 19, 12, 13, 14, 15 },
+		.corner = { 33, 69, 36, 64, 66, 38, 71, 35, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 25, 17, 26, 21, 24, 19, 27, 23, 20, 16, 18, 22, 12, 13, 14, 15 },
+		.corner = { 37, 65, 34, 70, 68, 32, 67, 39, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 10, 18, 11, 22, 9, 16, 8, 20, 21, 17, 19, 23, 12, 13, 14, 15 },
+		.corner = { 38, 66, 35, 71, 69, 33, 64, 36, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 27, 19, 24, 23, 26, 17, 25, 21, 22, 18, 16, 20, 12, 13, 14, 15 },
+		.corner = { 39, 67, 32, 68, 70, 34, 65, 37, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 8, 16, 9, 20, 11, 18, 10, 22, 23, 19, 17, 21, 12, 13, 14, 15 },
+		.corner = { 36, 64, 33, 69, 71, 35, 66, 38, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 16, 9, 20, 8, 18, 10, 22, 11, 3, 1, 5, 7, 12, 13, 14, 15 },
+		.corner = { 64, 33, 69, 36, 35, 66, 38, 71, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 17, 26, 21, 25, 19, 27, 23, 24, 0, 2, 6, 4, 12, 13, 14, 15 },
+		.corner = { 65, 34, 70, 37, 32, 67, 39, 68, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 18, 11, 22, 10, 16, 8, 20, 9, 1, 3, 7, 5, 12, 13, 14, 15 },
+		.corner = { 66, 35, 71, 38, 33, 64, 36, 69, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 19, 24, 23, 27, 17, 25, 21, 26, 2, 0, 4, 6, 12, 13, 14, 15 },
+		.corner = { 67, 32, 68, 39, 34, 65, 37, 70, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 20, 8, 16, 9, 22, 11, 18, 10, 5, 7, 3, 1, 12, 13, 14, 15 },
+		.corner = { 69, 36, 64, 33, 38, 71, 35, 66, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 23, 27, 19, 24, 21, 26, 17, 25, 4, 6, 2, 0, 12, 13, 14, 15 },
+		.corner = { 68, 39, 67, 32, 37, 70, 34, 65, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 22, 10, 18, 11, 20, 9, 16, 8, 7, 5, 1, 3, 12, 13, 14, 15 },
+		.corner = { 71, 38, 66, 35, 36, 69, 33, 64, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 21, 25, 17, 26, 23, 24, 19, 27, 6, 4, 0, 2, 12, 13, 14, 15 },
+		.corner = { 70, 37, 65, 34, 39, 68, 32, 67, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+};
+
+static const Cube trans_post[48] = {
+	{
+		.edge   = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 3, 0, 1, 2, 7, 4, 5, 6, 27, 24, 25, 26, 12, 13, 14, 15 },
+		.corner = { 3, 0, 1, 2, 7, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 12, 13, 14, 15 },
+		.corner = { 2, 3, 0, 1, 6, 7, 4, 5, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 1, 2, 3, 0, 5, 6, 7, 4, 25, 26, 27, 24, 12, 13, 14, 15 },
+		.corner = { 1, 2, 3, 0, 5, 6, 7, 4, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 4, 7, 6, 5, 0, 3, 2, 1, 9, 8, 11, 10, 12, 13, 14, 15 },
+		.corner = { 5, 4, 7, 6, 1, 0, 3, 2, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 7, 6, 5, 4, 3, 2, 1, 0, 24, 27, 26, 25, 12, 13, 14, 15 },
+		.corner = { 4, 7, 6, 5, 0, 3, 2, 1, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 6, 5, 4, 7, 2, 1, 0, 3, 11, 10, 9, 8, 12, 13, 14, 15 },
+		.corner = { 7, 6, 5, 4, 3, 2, 1, 0, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 5, 4, 7, 6, 1, 0, 3, 2, 26, 25, 24, 27, 12, 13, 14, 15 },
+		.corner = { 6, 5, 4, 7, 2, 1, 0, 3, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 24, 19, 27, 23, 25, 17, 26, 21, 20, 16, 18, 22, 12, 13, 14, 15 },
+		.corner = { 36, 64, 35, 71, 69, 33, 66, 38, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 23, 24, 19, 27, 21, 25, 17, 26, 6, 4, 0, 2, 12, 13, 14, 15 },
+		.corner = { 71, 36, 64, 35, 38, 69, 33, 66, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 27, 23, 24, 19, 26, 21, 25, 17, 18, 22, 20, 16, 12, 13, 14, 15 },
+		.corner = { 35, 71, 36, 64, 66, 38, 69, 33, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 19, 27, 23, 24, 17, 26, 21, 25, 0, 2, 6, 4, 12, 13, 14, 15 },
+		.corner = { 64, 35, 71, 36, 33, 66, 38, 69, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 25, 21, 26, 17, 24, 23, 27, 19, 16, 20, 22, 18, 12, 13, 14, 15 },
+		.corner = { 33, 69, 38, 66, 64, 36, 71, 35, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 21, 26, 17, 25, 23, 27, 19, 24, 4, 6, 2, 0, 12, 13, 14, 15 },
+		.corner = { 69, 38, 66, 33, 36, 71, 35, 64, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 26, 17, 25, 21, 27, 19, 24, 23, 22, 18, 16, 20, 12, 13, 14, 15 },
+		.corner = { 38, 66, 33, 69, 71, 35, 64, 36, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 17, 25, 21, 26, 19, 24, 23, 27, 2, 0, 4, 6, 12, 13, 14, 15 },
+		.corner = { 66, 33, 69, 38, 35, 64, 36, 71, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 16, 8, 20, 9, 18, 11, 22, 10, 1, 3, 7, 5, 12, 13, 14, 15 },
+		.corner = { 65, 32, 68, 37, 34, 67, 39, 70, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 8, 20, 9, 16, 11, 22, 10, 18, 19, 23, 21, 17, 12, 13, 14, 15 },
+		.corner = { 32, 68, 37, 65, 67, 39, 70, 34, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 20, 9, 16, 8, 22, 10, 18, 11, 7, 5, 1, 3, 12, 13, 14, 15 },
+		.corner = { 68, 37, 65, 32, 39, 70, 34, 67, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 9, 16, 8, 20, 10, 18, 11, 22, 21, 17, 19, 23, 12, 13, 14, 15 },
+		.corner = { 37, 65, 32, 68, 70, 34, 67, 39, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 18, 10, 22, 11, 16, 9, 20, 8, 3, 1, 5, 7, 12, 13, 14, 15 },
+		.corner = { 67, 34, 70, 39, 32, 65, 37, 68, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 11, 18, 10, 22, 8, 16, 9, 20, 23, 19, 17, 21, 12, 13, 14, 15 },
+		.corner = { 39, 67, 34, 70, 68, 32, 65, 37, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 22, 11, 18, 10, 20, 8, 16, 9, 5, 7, 3, 1, 12, 13, 14, 15 },
+		.corner = { 70, 39, 67, 34, 37, 68, 32, 65, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 10, 22, 11, 18, 9, 20, 8, 16, 17, 21, 23, 19, 12, 13, 14, 15 },
+		.corner = { 34, 70, 39, 67, 65, 37, 68, 32, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 0, 3, 2, 1, 4, 7, 6, 5, 9, 8, 11, 10, 12, 13, 14, 15 },
+		.corner = { 1, 0, 3, 2, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 3, 2, 1, 0, 7, 6, 5, 4, 24, 27, 26, 25, 12, 13, 14, 15 },
+		.corner = { 0, 3, 2, 1, 4, 7, 6, 5, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 2, 1, 0, 3, 6, 5, 4, 7, 11, 10, 9, 8, 12, 13, 14, 15 },
+		.corner = { 3, 2, 1, 0, 7, 6, 5, 4, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 1, 0, 3, 2, 5, 4, 7, 6, 26, 25, 24, 27, 12, 13, 14, 15 },
+		.corner = { 2, 1, 0, 3, 6, 5, 4, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 4, 5, 6, 7, 0, 1, 2, 3, 8, 9, 10, 11, 12, 13, 14, 15 },
+		.corner = { 4, 5, 6, 7, 0, 1, 2, 3, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 7, 4, 5, 6, 3, 0, 1, 2, 27, 24, 25, 26, 12, 13, 14, 15 },
+		.corner = { 7, 4, 5, 6, 3, 0, 1, 2, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 6, 7, 4, 5, 2, 3, 0, 1, 10, 11, 8, 9, 12, 13, 14, 15 },
+		.corner = { 6, 7, 4, 5, 2, 3, 0, 1, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 5, 6, 7, 4, 1, 2, 3, 0, 25, 26, 27, 24, 12, 13, 14, 15 },
+		.corner = { 5, 6, 7, 4, 1, 2, 3, 0, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 24, 23, 27, 19, 25, 21, 26, 17, 16, 20, 22, 18, 12, 13, 14, 15 },
+		.corner = { 64, 36, 71, 35, 33, 69, 38, 66, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 23, 27, 19, 24, 21, 26, 17, 25, 4, 6, 2, 0, 12, 13, 14, 15 },
+		.corner = { 36, 71, 35, 64, 69, 38, 66, 33, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 27, 19, 24, 23, 26, 17, 25, 21, 22, 18, 16, 20, 12, 13, 14, 15 },
+		.corner = { 71, 35, 64, 36, 38, 66, 33, 69, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 19, 24, 23, 27, 17, 25, 21, 26, 2, 0, 4, 6, 12, 13, 14, 15 },
+		.corner = { 35, 64, 36, 71, 66, 33, 69, 38, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 25, 17, 26, 21, 24, 19, 27, 23, 20, 16, 18, 22, 12, 13, 14, 15 },
+		.corner = { 69, 33, 66, 38, 36, 64, 35, 71, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 21, 25, 17, 26, 23, 24, 19, 27, 6, 4, 0, 2, 12, 13, 14, 15 },
+		.corner = { 38, 69, 33, 66, 71, 36, 64, 35, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 26, 21, 25, 17, 27, 23, 24, 19, 18, 22, 20, 16, 12, 13, 14, 15 },
+		.corner = { 66, 38, 69, 33, 35, 71, 36, 64, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 17, 26, 21, 25, 19, 27, 23, 24, 0, 2, 6, 4, 12, 13, 14, 15 },
+		.corner = { 33, 66, 38, 69, 64, 35, 71, 36, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 16, 9, 20, 8, 18, 10, 22, 11, 3, 1, 5, 7, 12, 13, 14, 15 },
+		.corner = { 32, 65, 37, 68, 67, 34, 70, 39, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 8, 16, 9, 20, 11, 18, 10, 22, 23, 19, 17, 21, 12, 13, 14, 15 },
+		.corner = { 68, 32, 65, 37, 39, 67, 34, 70, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 20, 8, 16, 9, 22, 11, 18, 10, 5, 7, 3, 1, 12, 13, 14, 15 },
+		.corner = { 37, 68, 32, 65, 70, 39, 67, 34, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 9, 20, 8, 16, 10, 22, 11, 18, 17, 21, 23, 19, 12, 13, 14, 15 },
+		.corner = { 65, 37, 68, 32, 34, 70, 39, 67, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 18, 11, 22, 10, 16, 8, 20, 9, 1, 3, 7, 5, 12, 13, 14, 15 },
+		.corner = { 34, 67, 39, 70, 65, 32, 68, 37, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 11, 22, 10, 18, 8, 20, 9, 16, 19, 23, 21, 17, 12, 13, 14, 15 },
+		.corner = { 67, 39, 70, 34, 32, 68, 37, 65, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 22, 10, 18, 11, 20, 9, 16, 8, 7, 5, 1, 3, 12, 13, 14, 15 },
+		.corner = { 39, 70, 34, 67, 68, 37, 65, 32, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+	{
+		.edge   = { 10, 18, 11, 22, 9, 16, 8, 20, 21, 17, 19, 23, 12, 13, 14, 15 },
+		.corner = { 70, 34, 67, 39, 37, 65, 32, 68, 8, 9, 10, 11, 12, 13, 14, 15 },
+	},
+};
+
+static const Move moves_ttable[NTRANS][NMOVES_ALL] = {
+	{
+		0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+		16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+		32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+		48, 49, 50, 51, 52, 53, 54,
+	},
+	{
+		0, 1, 2, 3, 4, 5, 6, 13, 14, 15, 16, 17, 18, 10, 11, 12,
+		7, 8, 9, 19, 20, 21, 22, 23, 24, 31, 32, 33, 34, 35, 36, 28,
+		29, 30, 25, 26, 27, 42, 41, 40, 37, 38, 39, 43, 44, 45, 52, 53,
+		54, 49, 50, 51, 48, 47, 46,
+	},
+	{
+		0, 1, 2, 3, 4, 5, 6, 10, 11, 12, 7, 8, 9, 16, 17, 18,
+		13, 14, 15, 19, 20, 21, 22, 23, 24, 28, 29, 30, 25, 26, 27, 34,
+		35, 36, 31, 32, 33, 39, 38, 37, 42, 41, 40, 43, 44, 45, 48, 47,
+		46, 49, 50, 51, 54, 53, 52,
+	},
+	{
+		0, 1, 2, 3, 4, 5, 6, 16, 17, 18, 13, 14, 15, 7, 8, 9,
+		10, 11, 12, 19, 20, 21, 22, 23, 24, 34, 35, 36, 31, 32, 33, 25,
+		26, 27, 28, 29, 30, 40, 41, 42, 39, 38, 37, 43, 44, 45, 54, 53,
+		52, 49, 50, 51, 46, 47, 48,
+	},
+	{
+		0, 4, 5, 6, 1, 2, 3, 10, 11, 12, 7, 8, 9, 13, 14, 15,
+		16, 17, 18, 22, 23, 24, 19, 20, 21, 28, 29, 30, 25, 26, 27, 31,
+		32, 33, 34, 35, 36, 39, 38, 37, 40, 41, 42, 45, 44, 43, 48, 47,
+		46, 51, 50, 49, 52, 53, 54,
+	},
+	{
+		0, 4, 5, 6, 1, 2, 3, 13, 14, 15, 16, 17, 18, 7, 8, 9,
+		10, 11, 12, 22, 23, 24, 19, 20, 21, 31, 32, 33, 34, 35, 36, 25,
+		26, 27, 28, 29, 30, 42, 41, 40, 39, 38, 37, 45, 44, 43, 52, 53,
+		54, 51, 50, 49, 46, 47, 48,
+	},
+	{
+		0, 4, 5, 6, 1, 2, 3, 7, 8, 9, 10, 11, 12, 16, 17, 18,
+		13, 14, 15, 22, 23, 24, 19, 20, 21, 25, 26, 27, 28, 29, 30, 34,
+		35, 36, 31, 32, 33, 37, 38, 39, 42, 41, 40, 45, 44, 43, 46, 47,
+		48, 51, 50, 49, 54, 53, 52,
+	},
+	{
+		0, 4, 5, 6, 1, 2, 3, 16, 17, 18, 13, 14, 15, 10, 11, 12,
+		7, 8, 9, 22, 23, 24, 19, 20, 21, 34, 35, 36, 31, 32, 33, 28,
+		29, 30, 25, 26, 27, 40, 41, 42, 37, 38, 39, 45, 44, 43, 54, 53,
+		52, 51, 50, 49, 48, 47, 46,
+	},
+	{
+		0, 10, 11, 12, 7, 8, 9, 1, 2, 3, 4, 5, 6, 13, 14, 15,
+		16, 17, 18, 28, 29, 30, 25, 26, 27, 19, 20, 21, 22, 23, 24, 31,
+		32, 33, 34, 35, 36, 43, 44, 45, 40, 41, 42, 39, 38, 37, 49, 50,
+		51, 48, 47, 46, 52, 53, 54,
+	},
+	{
+		0, 16, 17, 18, 13, 14, 15, 1, 2, 3, 4, 5, 6, 10, 11, 12,
+		7, 8, 9, 34, 35, 36, 31, 32, 33, 19, 20, 21, 22, 23, 24, 28,
+		29, 30, 25, 26, 27, 43, 44, 45, 37, 38, 39, 40, 41, 42, 49, 50,
+		51, 54, 53, 52, 48, 47, 46,
+	},
+	{
+		0, 7, 8, 9, 10, 11, 12, 1, 2, 3, 4, 5, 6, 16, 17, 18,
+		13, 14, 15, 25, 26, 27, 28, 29, 30, 19, 20, 21, 22, 23, 24, 34,
+		35, 36, 31, 32, 33, 43, 44, 45, 42, 41, 40, 37, 38, 39, 49, 50,
+		51, 46, 47, 48, 54, 53, 52,
+	},
+	{
+		0, 13, 14, 15, 16, 17, 18, 1, 2, 3, 4, 5, 6, 7, 8, 9,
+		10, 11, 12, 31, 32, 33, 34, 35, 36, 19, 20, 21, 22, 23, 24, 25,
+		26, 27, 28, 29, 30, 43, 44, 45, 39, 38, 37, 42, 41, 40, 49, 50,
+		51, 52, 53, 54, 46, 47, 48,
+	},
+	{
+		0, 7, 8, 9, 10, 11, 12, 4, 5, 6, 1, 2, 3, 13, 14, 15,
+		16, 17, 18, 25, 26, 27, 28, 29, 30, 22, 23, 24, 19, 20, 21, 31,
+		32, 33, 34, 35, 36, 45, 44, 43, 40, 41, 42, 37, 38, 39, 51, 50,
+		49, 46, 47, 48, 52, 53, 54,
+	},
+	{
+		0, 16, 17, 18, 13, 14, 15, 4, 5, 6, 1, 2, 3, 7, 8, 9,
+		10, 11, 12, 34, 35, 36, 31, 32, 33, 22, 23, 24, 19, 20, 21, 25,
+		26, 27, 28, 29, 30, 45, 44, 43, 39, 38, 37, 40, 41, 42, 51, 50,
+		49, 54, 53, 52, 46, 47, 48,
+	},
+	{
+		0, 10, 11, 12, 7, 8, 9, 4, 5, 6, 1, 2, 3, 16, 17, 18,
+		13, 14, 15, 28, 29, 30, 25, 26, 27, 22, 23, 24, 19, 20, 21, 34,
+		35, 36, 31, 32, 33, 45, 44, 43, 42, 41, 40, 39, 38, 37, 51, 50,
+		49, 48, 47, 46, 54, 53, 52,
+	},
+	{
+		0, 13, 14, 15, 16, 17, 18, 4, 5, 6, 1, 2, 3, 10, 11, 12,
+		7, 8, 9, 31, 32, 33, 34, 35, 36, 22, 23, 24, 19, 20, 21, 28,
+		29, 30, 25, 26, 27, 45, 44, 43, 37, 38, 39, 42, 41, 40, 51, 50,
+		49, 52, 53, 54, 48, 47, 46,
+	},
+	{
+		0, 13, 14, 15, 16, 17, 18, 10, 11, 12, 7, 8, 9, 1, 2, 3,
+		4, 5, 6, 31, 32, 33, 34, 35, 36, 28, 29, 30, 25, 26, 27, 19,
+		20, 21, 22, 23, 24, 39, 38, 37, 45, 44, 43, 42, 41, 40, 48, 47,
+		46, 52, 53, 54, 49, 50, 51,
+	},
+	{
+		0, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 1, 2, 3,
+		4, 5, 6, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 19,
+		20, 21, 22, 23, 24, 42, 41, 40, 45, 44, 43, 37, 38, 39, 52, 53,
+		54, 46, 47, 48, 49, 50, 51,
+	},
+	{
+		0, 16, 17, 18, 13, 14, 15, 7, 8, 9, 10, 11, 12, 1, 2, 3,
+		4, 5, 6, 34, 35, 36, 31, 32, 33, 25, 26, 27, 28, 29, 30, 19,
+		20, 21, 22, 23, 24, 37, 38, 39, 45, 44, 43, 40, 41, 42, 46, 47,
+		48, 54, 53, 52, 49, 50, 51,
+	},
+	{
+		0, 10, 11, 12, 7, 8, 9, 16, 17, 18, 13, 14, 15, 1, 2, 3,
+		4, 5, 6, 28, 29, 30, 25, 26, 27, 34, 35, 36, 31, 32, 33, 19,
+		20, 21, 22, 23, 24, 40, 41, 42, 45, 44, 43, 39, 38, 37, 54, 53,
+		52, 48, 47, 46, 49, 50, 51,
+	},
+	{
+		0, 13, 14, 15, 16, 17, 18, 7, 8, 9, 10, 11, 12, 4, 5, 6,
+		1, 2, 3, 31, 32, 33, 34, 35, 36, 25, 26, 27, 28, 29, 30, 22,
+		23, 24, 19, 20, 21, 37, 38, 39, 43, 44, 45, 42, 41, 40, 46, 47,
+		48, 52, 53, 54, 51, 50, 49,
+	},
+	{
+		0, 10, 11, 12, 7, 8, 9, 13, 14, 15, 16, 17, 18, 4, 5, 6,
+		1, 2, 3, 28, 29, 30, 25, 26, 27, 31, 32, 33, 34, 35, 36, 22,
+		23, 24, 19, 20, 21, 42, 41, 40, 43, 44, 45, 39, 38, 37, 52, 53,
+		54, 48, 47, 46, 51, 50, 49,
+	},
+	{
+		0, 16, 17, 18, 13, 14, 15, 10, 11, 12, 7, 8, 9, 4, 5, 6,
+		1, 2, 3, 34, 35, 36, 31, 32, 33, 28, 29, 30, 25, 26, 27, 22,
+		23, 24, 19, 20, 21, 39, 38, 37, 43, 44, 45, 40, 41, 42, 48, 47,
+		46, 54, 53, 52, 51, 50, 49,
+	},
+	{
+		0, 7, 8, 9, 10, 11, 12, 16, 17, 18, 13, 14, 15, 4, 5, 6,
+		1, 2, 3, 25, 26, 27, 28, 29, 30, 34, 35, 36, 31, 32, 33, 22,
+		23, 24, 19, 20, 21, 40, 41, 42, 43, 44, 45, 37, 38, 39, 54, 53,
+		52, 46, 47, 48, 51, 50, 49,
+	},
+	{
+		0, 3, 2, 1, 6, 5, 4, 12, 11, 10, 9, 8, 7, 15, 14, 13,
+		18, 17, 16, 21, 20, 19, 24, 23, 22, 30, 29, 28, 27, 26, 25, 33,
+		32, 31, 36, 35, 34, 37, 38, 39, 42, 41, 40, 45, 44, 43, 46, 47,
+		48, 51, 50, 49, 54, 53, 52,
+	},
+	{
+		0, 3, 2, 1, 6, 5, 4, 15, 14, 13, 18, 17, 16, 9, 8, 7,
+		12, 11, 10, 21, 20, 19, 24, 23, 22, 33, 32, 31, 36, 35, 34, 27,
+		26, 25, 30, 29, 28, 40, 41, 42, 37, 38, 39, 45, 44, 43, 54, 53,
+		52, 51, 50, 49, 48, 47, 46,
+	},
+	{
+		0, 3, 2, 1, 6, 5, 4, 9, 8, 7, 12, 11, 10, 18, 17, 16,
+		15, 14, 13, 21, 20, 19, 24, 23, 22, 27, 26, 25, 30, 29, 28, 36,
+		35, 34, 33, 32, 31, 39, 38, 37, 40, 41, 42, 45, 44, 43, 48, 47,
+		46, 51, 50, 49, 52, 53, 54,
+	},
+	{
+		0, 3, 2, 1, 6, 5, 4, 18, 17, 16, 15, 14, 13, 12, 11, 10,
+		9, 8, 7, 21, 20, 19, 24, 23, 22, 36, 35, 34, 33, 32, 31, 30,
+		29, 28, 27, 26, 25, 42, 41, 40, 39, 38, 37, 45, 44, 43, 52, 53,
+		54, 51, 50, 49, 46, 47, 48,
+	},
+	{
+		0, 6, 5, 4, 3, 2, 1, 9, 8, 7, 12, 11, 10, 15, 14, 13,
+		18, 17, 16, 24, 23, 22, 21, 20, 19, 27, 26, 25, 30, 29, 28, 33,
+		32, 31, 36, 35, 34, 39, 38, 37, 42, 41, 40, 43, 44, 45, 48, 47,
+		46, 49, 50, 51, 54, 53, 52,
+	},
+	{
+		0, 6, 5, 4, 3, 2, 1, 15, 14, 13, 18, 17, 16, 12, 11, 10,
+		9, 8, 7, 24, 23, 22, 21, 20, 19, 33, 32, 31, 36, 35, 34, 30,
+		29, 28, 27, 26, 25, 40, 41, 42, 39, 38, 37, 43, 44, 45, 54, 53,
+		52, 49, 50, 51, 46, 47, 48,
+	},
+	{
+		0, 6, 5, 4, 3, 2, 1, 12, 11, 10, 9, 8, 7, 18, 17, 16,
+		15, 14, 13, 24, 23, 22, 21, 20, 19, 30, 29, 28, 27, 26, 25, 36,
+		35, 34, 33, 32, 31, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+		48, 49, 50, 51, 52, 53, 54,
+	},
+	{
+		0, 6, 5, 4, 3, 2, 1, 18, 17, 16, 15, 14, 13, 9, 8, 7,
+		12, 11, 10, 24, 23, 22, 21, 20, 19, 36, 35, 34, 33, 32, 31, 27,
+		26, 25, 30, 29, 28, 42, 41, 40, 37, 38, 39, 43, 44, 45, 52, 53,
+		54, 49, 50, 51, 48, 47, 46,
+	},
+	{
+		0, 9, 8, 7, 12, 11, 10, 3, 2, 1, 6, 5, 4, 15, 14, 13,
+		18, 17, 16, 27, 26, 25, 30, 29, 28, 21, 20, 19, 24, 23, 22, 33,
+		32, 31, 36, 35, 34, 45, 44, 43, 42, 41, 40, 39, 38, 37, 51, 50,
+		49, 48, 47, 46, 54, 53, 52,
+	},
+	{
+		0, 18, 17, 16, 15, 14, 13, 3, 2, 1, 6, 5, 4, 9, 8, 7,
+		12, 11, 10, 36, 35, 34, 33, 32, 31, 21, 20, 19, 24, 23, 22, 27,
+		26, 25, 30, 29, 28, 45, 44, 43, 37, 38, 39, 42, 41, 40, 51, 50,
+		49, 52, 53, 54, 48, 47, 46,
+	},
+	{
+		0, 12, 11, 10, 9, 8, 7, 3, 2, 1, 6, 5, 4, 18, 17, 16,
+		15, 14, 13, 30, 29, 28, 27, 26, 25, 21, 20, 19, 24, 23, 22, 36,
+		35, 34, 33, 32, 31, 45, 44, 43, 40, 41, 42, 37, 38, 39, 51, 50,
+		49, 46, 47, 48, 52, 53, 54,
+	},
+	{
+		0, 15, 14, 13, 18, 17, 16, 3, 2, 1, 6, 5, 4, 12, 11, 10,
+		9, 8, 7, 33, 32, 31, 36, 35, 34, 21, 20, 19, 24, 23, 22, 30,
+		29, 28, 27, 26, 25, 45, 44, 43, 39, 38, 37, 40, 41, 42, 51, 50,
+		49, 54, 53, 52, 46, 47, 48,
+	},
+	{
+		0, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 15, 14, 13,
+		18, 17, 16, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 33,
+		32, 31, 36, 35, 34, 43, 44, 45, 42, 41, 40, 37, 38, 39, 49, 50,
+		51, 46, 47, 48, 54, 53, 52,
+	},
+	{
+		0, 18, 17, 16, 15, 14, 13, 6, 5, 4, 3, 2, 1, 12, 11, 10,
+		9, 8, 7, 36, 35, 34, 33, 32, 31, 24, 23, 22, 21, 20, 19, 30,
+		29, 28, 27, 26, 25, 43, 44, 45, 39, 38, 37, 42, 41, 40, 49, 50,
+		51, 52, 53, 54, 46, 47, 48,
+	},
+	{
+		0, 9, 8, 7, 12, 11, 10, 6, 5, 4, 3, 2, 1, 18, 17, 16,
+		15, 14, 13, 27, 26, 25, 30, 29, 28, 24, 23, 22, 21, 20, 19, 36,
+		35, 34, 33, 32, 31, 43, 44, 45, 40, 41, 42, 39, 38, 37, 49, 50,
+		51, 48, 47, 46, 52, 53, 54,
+	},
+	{
+		0, 15, 14, 13, 18, 17, 16, 6, 5, 4, 3, 2, 1, 9, 8, 7,
+		12, 11, 10, 33, 32, 31, 36, 35, 34, 24, 23, 22, 21, 20, 19, 27,
+		26, 25, 30, 29, 28, 43, 44, 45, 37, 38, 39, 40, 41, 42, 49, 50,
+		51, 54, 53, 52, 48, 47, 46,
+	},
+	{
+		0, 15, 14, 13, 18, 17, 16, 9, 8, 7, 12, 11, 10, 3, 2, 1,
+		6, 5, 4, 33, 32, 31, 36, 35, 34, 27, 26, 25, 30, 29, 28, 21,
+		20, 19, 24, 23, 22, 39, 38, 37, 43, 44, 45, 40, 41, 42, 48, 47,
+		46, 54, 53, 52, 51, 50, 49,
+	},
+	{
+		0, 12, 11, 10, 9, 8, 7, 15, 14, 13, 18, 17, 16, 3, 2, 1,
+		6, 5, 4, 30, 29, 28, 27, 26, 25, 33, 32, 31, 36, 35, 34, 21,
+		20, 19, 24, 23, 22, 40, 41, 42, 43, 44, 45, 37, 38, 39, 54, 53,
+		52, 46, 47, 48, 51, 50, 49,
+	},
+	{
+		0, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 3, 2, 1,
+		6, 5, 4, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 21,
+		20, 19, 24, 23, 22, 37, 38, 39, 43, 44, 45, 42, 41, 40, 46, 47,
+		48, 52, 53, 54, 51, 50, 49,
+	},
+	{
+		0, 9, 8, 7, 12, 11, 10, 18, 17, 16, 15, 14, 13, 3, 2, 1,
+		6, 5, 4, 27, 26, 25, 30, 29, 28, 36, 35, 34, 33, 32, 31, 21,
+		20, 19, 24, 23, 22, 42, 41, 40, 43, 44, 45, 39, 38, 37, 52, 53,
+		54, 48, 47, 46, 51, 50, 49,
+	},
+	{
+		0, 15, 14, 13, 18, 17, 16, 12, 11, 10, 9, 8, 7, 6, 5, 4,
+		3, 2, 1, 33, 32, 31, 36, 35, 34, 30, 29, 28, 27, 26, 25, 24,
+		23, 22, 21, 20, 19, 37, 38, 39, 45, 44, 43, 40, 41, 42, 46, 47,
+		48, 54, 53, 52, 49, 50, 51,
+	},
+	{
+		0, 9, 8, 7, 12, 11, 10, 15, 14, 13, 18, 17, 16, 6, 5, 4,
+		3, 2, 1, 27, 26, 25, 30, 29, 28, 33, 32, 31, 36, 35, 34, 24,
+		23, 22, 21, 20, 19, 40, 41, 42, 45, 44, 43, 39, 38, 37, 54, 53,
+		52, 48, 47, 46, 49, 50, 51,
+	},
+	{
+		0, 18, 17, 16, 15, 14, 13, 9, 8, 7, 12, 11, 10, 6, 5, 4,
+		3, 2, 1, 36, 35, 34, 33, 32, 31, 27, 26, 25, 30, 29, 28, 24,
+		23, 22, 21, 20, 19, 39, 38, 37, 45, 44, 43, 42, 41, 40, 48, 47,
+		46, 52, 53, 54, 49, 50, 51,
+	},
+	{
+		0, 12, 11, 10, 9, 8, 7, 18, 17, 16, 15, 14, 13, 6, 5, 4,
+		3, 2, 1, 30, 29, 28, 27, 26, 25, 36, 35, 34, 33, 32, 31, 24,
+		23, 22, 21, 20, 19, 42, 41, 40, 45, 44, 43, 37, 38, 39, 52, 53,
+		54, 46, 47, 48, 49, 50, 51,
+	},
+};
+
+static const Trans trans_ttable[NTRANS][NTRANS] = {
+	{
+		0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+		16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+		32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+	},
+	{
+		1, 2, 3, 0, 7, 4, 5, 6, 9, 10, 11, 8, 15, 12, 13, 14,
+		19, 16, 17, 18, 21, 22, 23, 20, 27, 24, 25, 26, 29, 30, 31, 28,
+		35, 32, 33, 34, 37, 38, 39, 36, 41, 42, 43, 40, 47, 44, 45, 46,
+	},
+	{
+		2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+		18, 19, 16, 17, 22, 23, 20, 21, 26, 27, 24, 25, 30, 31, 28, 29,
+		34, 35, 32, 33, 38, 39, 36, 37, 42, 43, 40, 41, 46, 47, 44, 45,
+	},
+	{
+		3, 0, 1, 2, 5, 6, 7, 4, 11, 8, 9, 10, 13, 14, 15, 12,
+		17, 18, 19, 16, 23, 20, 21, 22, 25, 26, 27, 24, 31, 28, 29, 30,
+		33, 34, 35, 32, 39, 36, 37, 38, 43, 40, 41, 42, 45, 46, 47, 44,
+	},
+	{
+		4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11,
+		20, 21, 22, 23, 16, 17, 18, 19, 28, 29, 30, 31, 24, 25, 26, 27,
+		36, 37, 38, 39, 32, 33, 34, 35, 44, 45, 46, 47, 40, 41, 42, 43,
+	},
+	{
+		5, 6, 7, 4, 3, 0, 1, 2, 13, 14, 15, 12, 11, 8, 9, 10,
+		23, 20, 21, 22, 17, 18, 19, 16, 31, 28, 29, 30, 25, 26, 27, 24,
+		39, 36, 37, 38, 33, 34, 35, 32, 45, 46, 47, 44, 43, 40, 41, 42,
+	},
+	{
+		6, 7, 4, 5, 2, 3, 0, 1, 14, 15, 12, 13, 10, 11, 8, 9,
+		22, 23, 20, 21, 18, 19, 16, 17, 30, 31, 28, 29, 26, 27, 24, 25,
+		38, 39, 36, 37, 34, 35, 32, 33, 46, 47, 44, 45, 42, 43, 40, 41,
+	},
+	{
+		7, 4, 5, 6, 1, 2, 3, 0, 15, 12, 13, 14, 9, 10, 11, 8,
+		21, 22, 23, 20, 19, 16, 17, 18, 29, 30, 31, 28, 27, 24, 25, 26,
+		37, 38, 39, 36, 35, 32, 33, 34, 47, 44, 45, 46, 41, 42, 43, 40,
+	},
+	{
+		8, 21, 14, 19, 12, 17, 10, 23, 4, 22, 2, 16, 0, 18, 6, 20,
+		15, 1, 9, 7, 11, 5, 13, 3, 36, 41, 34, 47, 32, 45, 38, 43,
+		24, 42, 30, 44, 28, 46, 26, 40, 35, 29, 37, 27, 39, 25, 33, 31,
+	},
+	{
+		9, 22, 13, 18, 15, 16, 11, 20, 7, 23, 3, 19, 1, 17, 5, 21,
+		14, 2, 10, 6, 8, 4, 12, 0, 37, 42, 33, 46, 35, 44, 39, 40,
+		27, 43, 31, 47, 29, 45, 25, 41, 34, 30, 38, 26, 36, 24, 32, 28,
+	},
+	{
+		10, 23, 12, 17, 14, 19, 8, 21, 6, 20, 0, 18, 2, 16, 4, 22,
+		13, 3, 11, 5, 9, 7, 15, 1, 38, 43, 32, 45, 34, 47, 36, 41,
+		26, 40, 28, 46, 30, 44, 24, 42, 33, 31, 39, 25, 37, 27, 35, 29,
+	},
+	{
+		11, 20, 15, 16, 13, 18, 9, 22, 5, 21, 1, 17, 3, 19, 7, 23,
+		12, 0, 8, 4, 10, 6, 14, 2, 39, 40, 35, 44, 33, 46, 37, 42,
+		25, 41, 29, 45, 31, 47, 27, 43, 32, 28, 36, 24, 38, 26, 34, 30,
+	},
+	{
+		12, 17, 10, 23, 8, 21, 14, 19, 0, 18, 6, 20, 4, 22, 2, 16,
+		11, 5, 13, 3, 15, 1, 9, 7, 32, 45, 38, 43, 36, 41, 34, 47,
+		28, 46, 26, 40, 24, 42, 30, 44, 39, 25, 33, 31, 35, 29, 37, 27,
+	},
+	{
+		13, 18, 9, 22, 11, 20, 15, 16, 3, 19, 7, 23, 5, 21, 1, 17,
+		10, 6, 14, 2, 12, 0, 8, 4, 33, 46, 37, 42, 39, 40, 35, 44,
+		31, 47, 27, 43, 25, 41, 29, 45, 38, 26, 34, 30, 32, 28, 36, 24,
+	},
+	{
+		14, 19, 8, 21, 10, 23, 12, 17, 2, 16, 4, 22, 6, 20, 0, 18,
+		9, 7, 15, 1, 13, 3, 11, 5, 34, 47, 36, 41, 38, 43, 32, 45,
+		30, 44, 24, 42, 26, 40, 28, 46, 37, 27, 35, 29, 33, 31, 39, 25,
+	},
+	{
+		15, 16, 11, 20, 9, 22, 13, 18, 1, 17, 5, 21, 7, 23, 3, 19,
+		8, 4, 12, 0, 14, 2, 10, 6, 35, 44, 39, 40, 37, 42, 33, 46,
+		29, 45, 25, 41, 27, 43, 31, 47, 36, 24, 32, 28, 34, 30, 38, 26,
+	},
+	{
+		16, 11, 20, 15, 18, 9, 22, 13, 17, 5, 21, 1, 19, 7, 23, 3,
+		0, 8, 4, 12, 2, 10, 6, 14, 40, 35, 44, 39, 42, 33, 46, 37,
+		41, 29, 45, 25, 43, 31, 47, 27, 24, 32, 28, 36, 26, 34, 30, 38,
+	},
+	{
+		17, 10, 23, 12, 19, 8, 21, 14, 18, 6, 20, 0, 16, 4, 22, 2,
+		3, 11, 5, 13, 1, 9, 7, 15, 43, 32, 45, 38, 41, 34, 47, 36,
+		40, 28, 46, 26, 42, 30, 44, 24, 25, 33, 31, 39, 27, 35, 29, 37,
+	},
+	{
+		18, 9, 22, 13, 16, 11, 20, 15, 19, 7, 23, 3, 17, 5, 21, 1,
+		2, 10, 6, 14, 0, 8, 4, 12, 42, 33, 46, 37, 40, 35, 44, 39,
+		43, 31, 47, 27, 41, 29, 45, 25, 26, 34, 30, 38, 24, 32, 28, 36,
+	},
+	{
+		19, 8, 21, 14, 17, 10, 23, 12, 16, 4, 22, 2, 18, 6, 20, 0,
+		1, 9, 7, 15, 3, 11, 5, 13, 41, 34, 47, 36, 43, 32, 45, 38,
+		42, 30, 44, 24, 40, 28, 46, 26, 27, 35, 29, 37, 25, 33, 31, 39,
+	},
+	{
+		20, 15, 16, 11, 22, 13, 18, 9, 21, 1, 17, 5, 23, 3, 19, 7,
+		4, 12, 0, 8, 6, 14, 2, 10, 44, 39, 40, 35, 46, 37, 42, 33,
+		45, 25, 41, 29, 47, 27, 43, 31, 28, 36, 24, 32, 30, 38, 26, 34,
+	},
+	{
+		21, 14, 19, 8, 23, 12, 17, 10, 22, 2, 16, 4, 20, 0, 18, 6,
+		7, 15, 1, 9, 5, 13, 3, 11, 47, 36, 41, 34, 45, 38, 43, 32,
+		44, 24, 42, 30, 46, 26, 40, 28, 29, 37, 27, 35, 31, 39, 25, 33,
+	},
+	{
+		22, 13, 18, 9, 20, 15, 16, 11, 23, 3, 19, 7, 21, 1, 17, 5,
+		6, 14, 2, 10, 4, 12, 0, 8, 46, 37, 42, 33, 44, 39, 40, 35,
+		47, 27, 43, 31, 45, 25, 41, 29, 30, 38, 26, 34, 28, 36, 24, 32,
+	},
+	{
+		23, 12, 17, 10, 21, 14, 19, 8, 20, 0, 18, 6, 22, 2, 16, 4,
+		5, 13, 3, 11, 7, 15, 1, 9, 45, 38, 43, 32, 47, 36, 41, 34,
+		46, 26, 40, 28, 44, 24, 42, 30, 31, 39, 25, 33, 29, 37, 27, 35,
+	},
+	{
+		24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39,
+		40, 41, 42, 43, 44, 45, 46, 47, 0, 1, 2, 3, 4, 5, 6, 7,
+		8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23,
+	},
+	{
+		25, 26, 27, 24, 31, 28, 29, 30, 33, 34, 35, 32, 39, 36, 37, 38,
+		43, 40, 41, 42, 45, 46, 47, 44, 3, 0, 1, 2, 5, 6, 7, 4,
+		11, 8, 9, 10, 13, 14, 15, 12, 17, 18, 19, 16, 23, 20, 21, 22,
+	},
+	{
+		26, 27, 24, 25, 30, 31, 28, 29, 34, 35, 32, 33, 38, 39, 36, 37,
+		42, 43, 40, 41, 46, 47, 44, 45, 2, 3, 0, 1, 6, 7, 4, 5,
+		10, 11, 8, 9, 14, 15, 12, 13, 18, 19, 16, 17, 22, 23, 20, 21,
+	},
+	{
+		27, 24, 25, 26, 29, 30, 31, 28, 35, 32, 33, 34, 37, 38, 39, 36,
+		41, 42, 43, 40, 47, 44, 45, 46, 1, 2, 3, 0, 7, 4, 5, 6,
+		9, 10, 11, 8, 15, 12, 13, 14, 19, 16, 17, 18, 21, 22, 23, 20,
+	},
+	{
+		28, 29, 30, 31, 24, 25, 26, 27, 36, 37, 38, 39, 32, 33, 34, 35,
+		44, 45, 46, 47, 40, 41, 42, 43, 4, 5, 6, 7, 0, 1, 2, 3,
+		12, 13, 14, 15, 8, 9, 10, 11, 20, 21, 22, 23, 16, 17, 18, 19,
+	},
+	{
+		29, 30, 31, 28, 27, 24, 25, 26, 37, 38, 39, 36, 35, 32, 33, 34,
+		47, 44, 45, 46, 41, 42, 43, 40, 7, 4, 5, 6, 1, 2, 3, 0,
+		15, 12, 13, 14, 9, 10, 11, 8, 21, 22, 23, 20, 19, 16, 17, 18,
+	},
+	{
+		30, 31, 28, 29, 26, 27, 24, 25, 38, 39, 36, 37, 34, 35, 32, 33,
+		46, 47, 44, 45, 42, 43, 40, 41, 6, 7, 4, 5, 2, 3, 0, 1,
+		14, 15, 12, 13, 10, 11, 8, 9, 22, 23, 20, 21, 18, 19, 16, 17,
+	},
+	{
+		31, 28, 29, 30, 25, 26, 27, 24, 39, 36, 37, 38, 33, 34, 35, 32,
+		45, 46, 47, 44, 43, 40, 41, 42, 5, 6, 7, 4, 3, 0, 1, 2,
+		13, 14, 15, 12, 11, 8, 9, 10, 23, 20, 21, 22, 17, 18, 19, 16,
+	},
+	{
+		32, 45, 38, 43, 36, 41, 34, 47, 28, 46, 26, 40, 24, 42, 30, 44,
+		39, 25, 33, 31, 35, 29, 37, 27, 12, 17, 10, 23, 8, 21, 14, 19,
+		0, 18, 6, 20, 4, 22, 2, 16, 11, 5, 13, 3, 15, 1, 9, 7,
+	},
+	{
+		33, 46, 37, 42, 39, 40, 35, 44, 31, 47, 27, 43, 25, 41, 29, 45,
+		38, 26, 34, 30, 32, 28, 36, 24, 13, 18, 9, 22, 11, 20, 15, 16,
+		3, 19, 7, 23, 5, 21, 1, 17, 10, 6, 14, 2, 12, 0, 8, 4,
+	},
+	{
+		34, 47, 36, 41, 38, 43, 32, 45, 30, 44, 24, 42, 26, 40, 28, 46,
+		37, 27, 35, 29, 33, 31, 39, 25, 14, 19, 8, 21, 10, 23, 12, 17,
+		2, 16, 4, 22, 6, 20, 0, 18, 9, 7, 15, 1, 13, 3, 11, 5,
+	},
+	{
+		35, 44, 39, 40, 37, 42, 33, 46, 29, 45, 25, 41, 27, 43, 31, 47,
+		36, 24, 32, 28, 34, 30, 38, 26, 15, 16, 11, 20, 9, 22, 13, 18,
+		1, 17, 5, 21, 7, 23, 3, 19, 8, 4, 12, 0, 14, 2, 10, 6,
+	},
+	{
+		36, 41, 34, 47, 32, 45, 38, 43, 24, 42, 30, 44, 28, 46, 26, 40,
+		35, 29, 37, 27, 39, 25, 33, 31, 8, 21, 14, 19, 12, 17, 10, 23,
+		4, 22, 2, 16, 0, 18, 6, 20, 15, 1, 9, 7, 11, 5, 13, 3,
+	},
+	{
+		37, 42, 33, 46, 35, 44, 39, 40, 27, 43, 31, 47, 29, 45, 25, 41,
+		34, 30, 38, 26, 36, 24, 32, 28, 9, 22, 13, 18, 15, 16, 11, 20,
+		7, 23, 3, 19, 1, 17, 5, 21, 14, 2, 10, 6, 8, 4, 12, 0,
+	},
+	{
+		38, 43, 32, 45, 34, 47, 36, 41, 26, 40, 28, 46, 30, 44, 24, 42,
+		33, 31, 39, 25, 37, 27, 35, 29, 10, 23, 12, 17, 14, 19, 8, 21,
+		6, 20, 0, 18, 2, 16, 4, 22, 13, 3, 11, 5, 9, 7, 15, 1,
+	},
+	{
+		39, 40, 35, 44, 33, 46, 37, 42, 25, 41, 29, 45, 31, 47, 27, 43,
+		32, 28, 36, 24, 38, 26, 34, 30, 11, 20, 15, 16, 13, 18, 9, 22,
+		5, 21, 1, 17, 3, 19, 7, 23, 12, 0, 8, 4, 10, 6, 14, 2,
+	},
+	{
+		40, 35, 44, 39, 42, 33, 46, 37, 41, 29, 45, 25, 43, 31, 47, 27,
+		24, 32, 28, 36, 26, 34, 30, 38, 16, 11, 20, 15, 18, 9, 22, 13,
+		17, 5, 21, 1, 19, 7, 23, 3, 0, 8, 4, 12, 2, 10, 6, 14,
+	},
+	{
+		41, 34, 47, 36, 43, 32, 45, 38, 42, 30, 44, 24, 40, 28, 46, 26,
+		27, 35, 29, 37, 25, 33, 31, 39, 19, 8, 21, 14, 17, 10, 23, 12,
+		16, 4, 22, 2, 18, 6, 20, 0, 1, 9, 7, 15, 3, 11, 5, 13,
+	},
+	{
+		42, 33, 46, 37, 40, 35, 44, 39, 43, 31, 47, 27, 41, 29, 45, 25,
+		26, 34, 30, 38, 24, 32, 28, 36, 18, 9, 22, 13, 16, 11, 20, 15,
+		19, 7, 23, 3, 17, 5, 21, 1, 2, 10, 6, 14, 0, 8, 4, 12,
+	},
+	{
+		43, 32, 45, 38, 41, 34, 47, 36, 40, 28, 46, 26, 42, 30, 44, 24,
+		25, 33, 31, 39, 27, 35, 29, 37, 17, 10, 23, 12, 19, 8, 21, 14,
+		18, 6, 20, 0, 16, 4, 22, 2, 3, 11, 5, 13, 1, 9, 7, 15,
+	},
+	{
+		44, 39, 40, 35, 46, 37, 42, 33, 45, 25, 41, 29, 47, 27, 43, 31,
+		28, 36, 24, 32, 30, 38, 26, 34, 20, 15, 16, 11, 22, 13, 18, 9,
+		21, 1, 17, 5, 23, 3, 19, 7, 4, 12, 0, 8, 6, 14, 2, 10,
+	},
+	{
+		45, 38, 43, 32, 47, 36, 41, 34, 46, 26, 40, 28, 44, 24, 42, 30,
+		31, 39, 25, 33, 29, 37, 27, 35, 23, 12, 17, 10, 21, 14, 19, 8,
+		20, 0, 18, 6, 22, 2, 16, 4, 5, 13, 3, 11, 7, 15, 1, 9,
+	},
+	{
+		46, 37, 42, 33, 44, 39, 40, 35, 47, 27, 43, 31, 45, 25, 41, 29,
+		30, 38, 26, 34, 28, 36, 24, 32, 22, 13, 18, 9, 20, 15, 16, 11,
+		23, 3, 19, 7, 21, 1, 17, 5, 6, 14, 2, 10, 4, 12, 0, 8,
+	},
+	{
+		47, 36, 41, 34, 45, 38, 43, 32, 44, 24, 42, 30, 46, 26, 40, 28,
+		29, 37, 27, 35, 31, 39, 25, 33, 21, 14, 19, 8, 23, 12, 17, 10,
+		22, 2, 16, 4, 20, 0, 18, 6, 7, 15, 1, 9, 5, 13, 3, 11,
+	},
+};
+
+static const Trans trans_itable[NTRANS] = {
+	0, 3, 2, 1, 4, 5, 6, 7, 12, 23, 10, 17, 8, 21, 14, 19,
+	16, 11, 20, 15, 18, 13, 22, 9, 24, 25, 26, 27, 28, 31, 30, 29,
+	32, 45, 38, 43, 36, 47, 34, 41, 40, 39, 44, 35, 42, 33, 46, 37,
+};
@@ -1,15 +1,151 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <inttypes.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "cube.h"
 #include "coord.h"
 #include "solve.h"
 #include "steps.h"
+#include "pool.h"
+#include "nissy.h"
+
+/* The depths counted by struct nissy_stats are those of a SolveStats */
+typedef char check_stats_depths[NISSY_STATS_DEPTHS == MAX_ALG_LEN+1 ? 1 : -1];
+
+/*
+ * Errors in the arguments of the solve functions, each of them maps these
+ * to the position of the corresponding argument.
+ */
+enum {
+	BAD_STEP = 1, BAD_TRANS, BAD_DEPTH, BAD_TYPE, BAD_SCRAMBLE, BAD_THREADS,
+	BAD_MAX
+};
 
+typedef struct {
+	char *buf;
+	size_t size;
+	size_t len;
+	size_t needed;
+} BufSink;
+
+typedef struct {
+	Step *s;
+	Trans t;
+	SolutionType st;
+	SolveOptions opts;
+	char **scrs;
+	char **sols;
+	size_t size;
+	size_t *needed;
+	int *results;
+} BatchArg;
+
+typedef void (LabelSink)(char *, char *, void *);
+
+typedef struct {
+	Trans t;
+	LabelSink *sink;
+	void *data;
+} Label;
+
+typedef struct {
+	Step *s;
+	SolutionType st;
+	Cube cube;
+	int n;
+	Trans t[NTRANS];
+	SolveOptions opts;
+	SolBuf buf[NTRANS];
+	int result[NTRANS];
+	bool done[NTRANS];
+	int prefix;
+	LabelSink *sink;
+	void *data;
+	PoolLock lock;
+	bool flushing;
+} MultiArg;
+
+static void init(void);
 static bool set_step(char *, Step **);
 static bool set_solutiontype(char *, SolutionType *);
 static bool set_trans(char *, Trans *);
+static int set_trans_list(char *, Trans *);
+#ifndef _WIN32
+static char *map_file(char *, size_t *);
+#endif
+static size_t readfile(void *, void *, size_t);
+static int add_needed(Coordinate *, Coordinate **, int);
+static bool load_step(Step *);
+static int solve_args(char *, char *, char *, char *, SolveOptions *,
+    const int *);
+static void write_str(char *, void *);
+static void write_buf(char *, void *);
+static void solve_batch_one(void *, int);
+static void write_grow(char *, void *);
+static void write_label(char *, void *);
+static void solve_multi_one(void *, int);
+static void flush_multi(MultiArg *, int);
+
+/* Maximum number of coordinates that a step can depend on */
+#define MAX_NEEDED (3*MAX_N_COORD)
+
+/*
+ * In lazy mode the tables file is kept mapped (or, if mmap() is not
+ * available, its path is kept) and the tables of each coordinate are
+ * only loaded the first time a step using them is solved.
+ */
+static char *lazy_buf;
+static size_t lazy_size;
+static char *lazy_path;
+
+/* Taken by load_step(), so that a step can be solved by many threads */
+static PoolLock load_lock = POOL_LOCK_INITIALIZER;
+
+/* The tables file mapped by nissy_init_mmap() */
+static char *map_buf;
+static size_t map_size;
+
+void
+nissy_free(void)
+{
+	free_tables(coordinates);
+
+#ifndef _WIN32
+	if (map_buf != NULL)
+		munmap(map_buf, map_size);
+	if (lazy_buf != NULL)
+		munmap(lazy_buf, lazy_size);
+#endif
+	free(lazy_path);
+
+	map_buf = NULL;
+	lazy_buf = NULL;
+	lazy_path = NULL;
+}
+
+static void
+init(void)
+{
+	int i;
+
+	nissy_free();
+	init_cube();
+	for (i = 0; steps[i] != NULL; i++)
+		init_step(steps[i]);
+}
 
 static bool
 set_step(char *str, Step **step)
@@ -48,37 +184,200 @@ set_solutiontype(char *str, SolutionType *st)
 static bool
 set_trans(char *str, Trans *t)
 {
-	if (!strcmp(str, "uf")) {
-		*t = uf;
-		return true;
+	return read_trans(str, t);
+}
+
+/*
+ * A list of transformations separated by spaces or commas, or "all".
+ * Returns the number of transformations, 0 if the list is not valid.
+ */
+static int
+set_trans_list(char *str, Trans *t)
+{
+	int i, j, n;
+	char name[20];
+
+	if (!strcmp(str, "all")) {
+		for (n = 0; n < NTRANS; n++)
+			t[n] = n;
+		return n;
 	}
-	if (!strcmp(str, "fr")) {
-		*t = fr;
-		return true;
+
+	for (i = 0, n = 0; str[i]; ) {
+		for ( ; str[i] == ' ' || str[i] == ','; i++) ;
+		for (j = 0; str[i] && str[i] != ' ' && str[i] != ','; i++, j++)
+			if (j < 19)
+				name[j] = str[i];
+		if (j == 0)
+			break;
+		if (j >= 20 || n == NTRANS)
+			return 0;
+		name[j] = 0;
+		if (!read_trans(name, &t[n++]))
+			return 0;
 	}
-	if (!strcmp(str, "rd")) {
-		*t = rd;
-		return true;
+
+	return n;
+}
+
+#ifndef _WIN32
+static char *
+map_file(char *path, size_t *size)
+{
+	int fd;
+	struct stat st;
+	void *buf;
+
+	if ((fd = open(path, O_RDONLY)) == -1)
+		return NULL;
+
+	if (fstat(fd, &st) == -1) {
+		close(fd);
+		return NULL;
 	}
 
-	return false;
+	*size = st.st_size;
+	buf = mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	return buf == MAP_FAILED ? NULL : buf;
 }
+#endif
 
-void
-nissy_init(char *buf)
+static size_t
+readfile(void *file, void *buf, size_t n)
+{
+	return fread(buf, 1, n, file);
+}
+
+static int
+add_needed(Coordinate *coord, Coordinate **list, int n)
 {
 	int i;
-	size_t b;
 
-	init_cube();
+	if (coord == NULL || coord->generated)
+		return n;
+
+	for (i = 0; i < n; i++)
+		if (list[i] == coord)
+			return n;
+
+	/* The base coordinates of a SYM coordinate have no tables */
+	if (coord->type == SYMCOMP_COORD) {
+		n = add_needed(coord->base[0], list, n);
+		n = add_needed(coord->base[1], list, n);
+	}
+	list[n++] = coord;
+
+	return n;
+}
+
+static bool
+load_step(Step *s)
+{
+	int i, n;
+	bool r;
+	FILE *file;
+	Coordinate *list[MAX_NEEDED+1];
+
+	pool_lock(&load_lock);
+
+	for (i = 0, n = 0; s->coord[i] != NULL; i++)
+		n = add_needed(s->coord[i], list, n);
+	list[n] = NULL;
+
+	if (n == 0)
+		r = true;
+	else if (lazy_buf != NULL)
+		r = map_tables(list, lazy_buf, lazy_size);
+	else if (lazy_path != NULL && (file = fopen(lazy_path, "rb")) != NULL) {
+		r = read_tables_stream(list, readfile, file);
+		fclose(file);
+	} else
+		r = false;
+
+	pool_unlock(&load_lock);
+
+	return r;
+}
+
+int
+nissy_init(char *buf, size_t size)
+{
+	init();
+
+	return read_tables(coordinates, buf, size) ? 0 : 1;
+}
+
+int
+nissy_init_file(char *path)
+{
+	bool r;
+	FILE *file;
+
+	init();
+
+	if ((file = fopen(path, "rb")) == NULL)
+		return 1;
+
+	r = read_tables_stream(coordinates, readfile, file);
+	fclose(file);
+
+	return r ? 0 : 2;
+}
 
-	b = 0;
-	for (i = 0; coordinates[i] != NULL; i++)
-		b += read_coord(coordinates[i], &buf[b]);
+#ifndef _WIN32
+int
+nissy_init_mmap(char *path)
+{
+	init();
+
+	if ((map_buf = map_file(path, &map_size)) == NULL)
+		return 1;
+
+	return map_tables(coordinates, map_buf, map_size) ? 0 : 2;
+}
+#else
+/* No mmap() here, the tables are read one section at a time instead */
+int
+nissy_init_mmap(char *path)
+{
+	return nissy_init_file(path);
 }
+#endif
 
 int
-nissy_solve(char *step, char *trans, int d, char *type, char *scramble, char *sol)
+nissy_init_lazy(char *path)
+{
+	Coordinate *none[] = { NULL };
+
+	init();
+
+#ifndef _WIN32
+	if ((lazy_buf = map_file(path, &lazy_size)) == NULL)
+		return 1;
+
+	return map_tables(none, lazy_buf, lazy_size) ? 0 : 2;
+#else
+	FILE *file;
+	bool r;
+
+	if ((file = fopen(path, "rb")) == NULL)
+		return 1;
+	r = read_tables_stream(none, readfile, file);
+	fclose(file);
+
+	if ((lazy_path = malloc(strlen(path) + 1)) == NULL)
+		return 1;
+	strcpy(lazy_path, path);
+
+	return r ? 0 : 2;
+#endif
+}
+
+static int
+solve_args(char *step, char *trans, char *type, char *scramble,
+    SolveOptions *opts, const int *pos)
 {
 	Cube c;
 	Step *s;
@@ -86,14 +385,403 @@ nissy_solve(char *step, char *trans, int d, char *type, char *scramble, char *so
 	SolutionType st;
 
 	make_solved(&c);
-	if (!set_step(step, &s)) return 1;
-	if (!set_trans(trans, &t)) return 2;
-	if (!set_solutiontype(type, &st)) return 4;
-	if (!apply_scramble(scramble, &c)) return 5;
+	if (!set_step(step, &s) || !load_step(s)) return pos[BAD_STEP];
+	if (!set_trans(trans, &t)) return pos[BAD_TRANS];
+	if (opts->mindepth < 0) return pos[BAD_DEPTH];
+	if (!set_solutiontype(type, &st)) return pos[BAD_TYPE];
+	if (!apply_scramble(scramble, &c)) return pos[BAD_SCRAMBLE];
+	if (opts->threads < 1) return pos[BAD_THREADS];
+	if (opts->max < 0) return pos[BAD_MAX];
+
+	return solve(s, t, st, &c, opts) ? -1 : 0;
+}
+
+/* Appends to a string that is assumed to be large enough */
+static void
+write_str(char *sol, void *data)
+{
+	char **str = (char **)data;
+	size_t n;
+
+	n = strlen(sol);
+	memcpy(*str, sol, n);
+	(*str)[n] = '\n';
+	(*str)[n+1] = 0;
+	*str += n+1;
+}
+
+/*
+ * Appends to a buffer of fixed size, as long as the solution fits with
+ * the terminator and all the previous ones did. The size that would be
+ * needed for all of them is counted anyway.
+ */
+static void
+write_buf(char *sol, void *data)
+{
+	BufSink *b = (BufSink *)data;
+	size_t n;
+
+	n = strlen(sol);
+	if (b->len == b->needed && b->len + n + 1 < b->size) {
+		memcpy(b->buf + b->len, sol, n);
+		b->buf[b->len + n] = '\n';
+		b->buf[b->len + n + 1] = 0;
+		b->len += n+1;
+	}
+	b->needed += n+1;
+}
+
+int
+nissy_solve_cb(char *step, char *trans, int mindepth, int maxdepth,
+    int optimal, char *type, char *scramble, void (*sink)(char *, void *),
+    void *data, int threads, int max_solutions)
+{
+	static const int pos[] = {
+	    [BAD_STEP] = 1, [BAD_TRANS] = 2, [BAD_DEPTH] = 3,
+	    [BAD_TYPE] = 6,
+	    [BAD_SCRAMBLE] = 7, [BAD_THREADS] = 10, [BAD_MAX] = 11 };
+	SolveOptions opts;
+
+	opts.mindepth = mindepth;
+	opts.maxdepth = maxdepth;
+	opts.optimal  = optimal;
+	opts.max      = max_solutions;
+	opts.threads  = threads;
+	opts.sink     = sink;
+	opts.data     = data;
+	opts.stats    = NULL;
+
+	return solve_args(step, trans, type, scramble, &opts, pos);
+}
+
+int
+nissy_solve_stats(char *step, char *trans, int mindepth, int maxdepth,
+    int optimal, char *type, char *scramble, void (*sink)(char *, void *),
+    void *data, int threads, int max_solutions, struct nissy_stats *stats)
+{
+	static const int pos[] = {
+	    [BAD_STEP] = 1, [BAD_TRANS] = 2, [BAD_DEPTH] = 3,
+	    [BAD_TYPE] = 6,
+	    [BAD_SCRAMBLE] = 7, [BAD_THREADS] = 10, [BAD_MAX] = 11 };
+	int i, r;
+	SolveOptions opts;
+	SolveStats st;
+
+	opts.mindepth = mindepth;
+	opts.maxdepth = maxdepth;
+	opts.optimal  = optimal;
+	opts.max      = max_solutions;
+	opts.threads  = threads;
+	opts.sink     = sink;
+	opts.data     = data;
+	opts.stats    = &st;
+
+	memset(&st, 0, sizeof(st));
+	r = solve_args(step, trans, type, scramble, &opts, pos);
+
+	for (i = 0; i < NISSY_STATS_DEPTHS; i++)
+		stats->nodes[i] = st.nodes[i];
+	stats->pruned        = st.pruned;
+	stats->shortened     = st.shortened;
+	stats->nissed        = st.nissed;
+	stats->niss_rejected = st.niss_rejected;
+	stats->fallbacks     = st.fallbacks;
+
+	return r;
+}
+
+int
+nissy_solve_buf(char *step, char *trans, int mindepth, int maxdepth,
+    int optimal, char *type, char *scramble, char *sol, size_t size,
+    size_t *needed, int threads, int max_solutions)
+{
+	static const int pos[] = {
+	    [BAD_STEP] = 1, [BAD_TRANS] = 2, [BAD_DEPTH] = 3,
+	    [BAD_TYPE] = 6,
+	    [BAD_SCRAMBLE] = 7, [BAD_THREADS] = 11, [BAD_MAX] = 12 };
+	int r;
+	BufSink b;
+	SolveOptions opts;
+
+	b.buf    = sol;
+	b.size   = size;
+	b.len    = 0;
+	b.needed = 0;
+	if (size > 0)
+		sol[0] = 0;
+
+	opts.mindepth = mindepth;
+	opts.maxdepth = maxdepth;
+	opts.optimal  = optimal;
+	opts.max      = max_solutions;
+	opts.threads  = threads;
+	opts.sink     = write_buf;
+	opts.data     = &b;
+	opts.stats    = NULL;
+
+	r = solve_args(step, trans, type, scramble, &opts, pos);
+	*needed = b.needed + 1;
+
+	return r;
+}
+
+static void
+solve_batch_one(void *data, int i)
+{
+	Cube c;
+	BufSink b;
+	SolveOptions opts;
+	BatchArg *arg = (BatchArg *)data;
+
+	b.buf    = arg->sols[i];
+	b.size   = arg->size;
+	b.len    = 0;
+	b.needed = 0;
+	if (b.size > 0)
+		b.buf[0] = 0;
+
+	opts = arg->opts;
+	opts.data = &b;
+
+	make_solved(&c);
+	if (!apply_scramble(arg->scrs[i], &c))
+		arg->results[i] = 1;
+	else
+		arg->results[i] = solve(arg->s, arg->t, arg->st, &c, &opts) ? -1 : 0;
+	arg->needed[i] = b.needed + 1;
+}
+
+int
+nissy_solve_batch(char *step, char *trans, int mindepth, int maxdepth,
+    int optimal, char *type, int n, char **scrs, char **sols, size_t size,
+    size_t *needed, int *results, int threads, int max_solutions)
+{
+	BatchArg arg;
+
+	if (!set_step(step, &arg.s) || !load_step(arg.s)) return 1;
+	if (!set_trans(trans, &arg.t)) return 2;
+	if (mindepth < 0) return 3;
+	if (!set_solutiontype(type, &arg.st)) return 6;
+	if (n < 0) return 7;
+	if (threads < 1) return 13;
+	if (max_solutions < 0) return 14;
+	if (n == 0) return 0;
+
+	/* If there are more threads than scrambles, each search is split */
+	arg.opts.mindepth = mindepth;
+	arg.opts.maxdepth = maxdepth;
+	arg.opts.optimal  = optimal;
+	arg.opts.max      = max_solutions;
+	arg.opts.threads  = threads > n ? threads / n : 1;
+	arg.opts.sink     = write_buf;
+	arg.opts.data     = NULL;
+	arg.opts.stats    = NULL;
+
+	arg.scrs    = scrs;
+	arg.sols    = sols;
+	arg.size    = size;
+	arg.needed  = needed;
+	arg.results = results;
+
+	run_pool(threads, n, solve_batch_one, &arg);
 
-	sol[0] = 'h'; sol[1] = 'e'; sol[2] = 'l'; sol[3] = 'o'; sol[5] = 0;
 	return 0;
-	//return solve(s, t, d, st, &c, sol);
+}
+
+/* Appends to a buffer that grows as needed */
+static void
+write_grow(char *sol, void *data)
+{
+	SolBuf *b = (SolBuf *)data;
+	size_t n, size;
+	char *str;
+
+	n = strlen(sol);
+	if (b->error)
+		return;
+	if (b->len + n + 1 > b->size) {
+		size = MAX(2 * b->size, b->len + n + 1);
+		if ((str = realloc(b->str, size)) == NULL) {
+			b->error = true;
+			return;
+		}
+		b->str = str;
+		b->size = size;
+	}
+	memcpy(b->str + b->len, sol, n);
+	b->str[b->len + n] = '\n';
+	b->len += n+1;
+}
+
+static void
+write_label(char *sol, void *data)
+{
+	Label *l = (Label *)data;
+
+	l->sink(trans_name(l->t), sol, l->data);
+}
+
+static void
+solve_multi_one(void *data, int i)
+{
+	Cube c;
+	SolveOptions opts;
+	MultiArg *arg = (MultiArg *)data;
+
+	copy_cube(&arg->cube, &c);
+	opts = arg->opts;
+	opts.sink = write_grow;
+	opts.data = &arg->buf[i];
+	arg->result[i] = solve(arg->s, arg->t[i], arg->st, &c, &opts);
+
+	pool_lock(&arg->lock);
+	arg->done[i] = true;
+	if (arg->flushing) {
+		pool_unlock(&arg->lock);
+		return;
+	}
+	arg->flushing = true;
+	for ( ; arg->prefix < arg->n && arg->done[arg->prefix]; arg->prefix++) {
+		pool_unlock(&arg->lock);
+		flush_multi(arg, arg->prefix);
+		pool_lock(&arg->lock);
+	}
+	arg->flushing = false;
+	pool_unlock(&arg->lock);
+}
+
+/*
+ * Sends the solutions for the i-th transformation to the user, once all
+ * the previous ones have been sent. Only one thread at a time flushes, and
+ * it does not hold arg->lock, so that the other searches can go on.
+ */
+static void
+flush_multi(MultiArg *arg, int i)
+{
+	char *str, *end;
+	Cube c;
+	Label l;
+	SolveOptions opts;
+	SolBuf *b = &arg->buf[i];
+
+	if (b->error) {
+		/* Out of memory, search again sending solutions directly */
+		l.t = arg->t[i];
+		l.sink = arg->sink;
+		l.data = arg->data;
+		copy_cube(&arg->cube, &c);
+		opts = arg->opts;
+		opts.threads = 1;
+		opts.sink = write_label;
+		opts.data = &l;
+		arg->result[i] = solve(arg->s, arg->t[i], arg->st, &c, &opts);
+	} else {
+		for (str = b->str; str < b->str + b->len; str = end + 1) {
+			end = memchr(str, '\n', b->len - (str - b->str));
+			*end = 0;
+			arg->sink(trans_name(arg->t[i]), str, arg->data);
+		}
+	}
+
+	free(b->str);
+	b->str = NULL;
+}
+
+int
+nissy_solve_multi(char *step, char *trans, int mindepth, int maxdepth,
+    int optimal, char *type, char *scramble,
+    void (*sink)(char *, char *, void *), void *data, int threads,
+    int max_solutions)
+{
+	int i, r;
+	MultiArg arg;
+
+	make_solved(&arg.cube);
+	if (!set_step(step, &arg.s) || !load_step(arg.s)) return 1;
+	if ((arg.n = set_trans_list(trans, arg.t)) == 0) return 2;
+	if (mindepth < 0) return 3;
+	if (!set_solutiontype(type, &arg.st)) return 6;
+	if (!apply_scramble(scramble, &arg.cube)) return 7;
+	if (threads < 1) return 10;
+	if (max_solutions < 0) return 11;
+
+	/* If there are more threads than transformations, each is split */
+	arg.opts.mindepth = mindepth;
+	arg.opts.maxdepth = maxdepth;
+	arg.opts.optimal  = optimal;
+	arg.opts.max      = max_solutions;
+	arg.opts.threads  = threads > arg.n ? threads / arg.n : 1;
+	arg.opts.stats    = NULL;
+
+	arg.prefix   = 0;
+	arg.flushing = false;
+	arg.sink     = sink;
+	arg.data   = data;
+	for (i = 0; i < arg.n; i++) {
+		arg.buf[i].str   = NULL;
+		arg.buf[i].len   = 0;
+		arg.buf[i].size  = 0;
+		arg.buf[i].error = false;
+		arg.done[i]      = false;
+	}
+
+	pool_lock_init(&arg.lock);
+	run_pool(threads, arg.n, solve_multi_one, &arg);
+	pool_lock_destroy(&arg.lock);
+
+	for (i = 0, r = 0; i < arg.n; i++)
+		r = r || arg.result[i];
+
+	return r ? -1 : 0;
+}
+
+int
+nissy_solve_range(char *step, char *trans, int mindepth, int maxdepth,
+    int optimal, char *type, char *scramble, char *sol, int threads,
+    int max_solutions)
+{
+	static const int pos[] = {
+	    [BAD_STEP] = 1, [BAD_TRANS] = 2, [BAD_DEPTH] = 3,
+	    [BAD_TYPE] = 6,
+	    [BAD_SCRAMBLE] = 7, [BAD_THREADS] = 9, [BAD_MAX] = 10 };
+	SolveOptions opts;
+
+	*sol = 0;
+
+	opts.mindepth = mindepth;
+	opts.maxdepth = maxdepth;
+	opts.optimal  = optimal;
+	opts.max      = max_solutions;
+	opts.threads  = threads;
+	opts.sink     = write_str;
+	opts.data     = &sol;
+	opts.stats    = NULL;
+
+	return solve_args(step, trans, type, scramble, &opts, pos);
+}
+
+int
+nissy_solve(char *step, char *trans, int d, char *type, char *scramble,
+    char *sol, int threads, int max_solutions)
+{
+	static const int pos[] = {
+	    [BAD_STEP] = 1, [BAD_TRANS] = 2, [BAD_DEPTH] = 3,
+	    [BAD_TYPE] = 4,
+	    [BAD_SCRAMBLE] = 5, [BAD_THREADS] = 7, [BAD_MAX] = 8 };
+	SolveOptions opts;
+
+	*sol = 0;
+
+	opts.mindepth = d;
+	opts.maxdepth = d;
+	opts.optimal  = -1;
+	opts.max      = max_solutions;
+	opts.threads  = threads;
+	opts.sink     = write_str;
+	opts.data     = &sol;
+	opts.stats    = NULL;
+
+	return solve_args(step, trans, type, scramble, &opts, pos);
 }
 
 void
@@ -1,18 +1,215 @@
-/* TODO: find a better way to define this */
-#define TABLESFILESIZE 700000 /* 700Kb */
+#include <stddef.h>
+#include <stdint.h>
 
-/* Initialize nissy, to be called on startup */
-void nissy_init(char *);
+/*
+ * Initialize nissy, to be called on startup. The tables are copied from
+ * the given buffer of size bytes, which can be freed afterwards.
+ * Returns 0 on success, 1 if the tables are not valid, for example if the
+ * buffer is too short for them.
+ */
+int nissy_init(char *, size_t);
+
+/*
+ * Initialize nissy with the tables file at the given path, without copying
+ * it: the file is mapped in memory, so the tables are only loaded when used
+ * and they are shared between processes.
+ * Returns 0 on success, 1 if the file cannot be mapped, 2 if the tables
+ * are not valid.
+ */
+int nissy_init_mmap(char *);
+
+/*
+ * Initialize nissy with the tables file at the given path, reading it one
+ * section at a time. Only the tables themselves are kept in memory.
+ * Returns 0 on success, 1 if the file cannot be opened, 2 if the tables
+ * are not valid.
+ */
+int nissy_init_file(char *);
+
+/*
+ * Initialize nissy with the tables file at the given path, without loading
+ * any table yet. The tables needed by a step are loaded the first time the
+ * step is solved, so that only the tables that are actually used take up
+ * memory. The file must not change while nissy is running. Steps can be
+ * solved from many threads at the same time, even before their tables are
+ * loaded: the other threads wait while they are.
+ * Returns 0 on success, 1 if the file cannot be opened, 2 if the tables
+ * are not valid.
+ */
+int nissy_init_lazy(char *);
+
+/*
+ * Release the tables and any mapped file. Afterwards nissy can be
+ * initialized again, which also releases the previous tables.
+ */
+void nissy_free(void);
 
 /* Test that nissy is responsive */
 void nissy_test(char *);
 
-/* Returns 0 on success, 1-based index of bad arg on failure */
+/*
+ * Returns 0 on success, 1-based index of bad arg on failure. An unknown step
+ * and a step whose tables cannot be loaded both count as a bad step.
+ * Returns -1 if the search was stopped after finding max_solutions
+ * solutions, in which case there may be more that were not listed.
+ */
 int nissy_solve(
 	char *step,  /* "eofb" */
 	char *trans, /* "uf" or similar */
 	int depth,   /* Number of moves */
 	char *type,  /* "normal" or "inverse" or "niss" */
 	char *scr,   /* The scramble */
-	char *sol    /* The solution, as a single string, \n-separated */
+	char *sol,   /* The solutions, \n-separated, must be large enough */
+	int threads, /* Number of threads to use, at least 1 */
+	int max_solutions /* Stop after this many solutions, 0 for no limit */
+);
+
+/*
+ * Same as nissy_solve(), but with solutions of any length between mindepth
+ * and maxdepth, listed by increasing length. If optimal is not negative,
+ * only the solutions that are at most optimal moves longer than the
+ * shortest ones are listed; for example mindepth = 0, maxdepth = 20 and
+ * optimal = 0 gives all the optimal solutions.
+ * The return value is as for nissy_solve().
+ */
+int nissy_solve_range(
+	char *step,
+	char *trans,
+	int mindepth, /* Minimum number of moves */
+	int maxdepth, /* Maximum number of moves */
+	int optimal,  /* Moves more than optimal allowed, negative to ignore */
+	char *type,
+	char *scr,
+	char *sol,
+	int threads,
+	int max_solutions
+);
+
+/*
+ * Same as nissy_solve_range(), but each solution is passed to sink as soon
+ * as it is found, as a string without newline, together with data. The
+ * string is only valid during the call. With more than one thread, sink
+ * can be called from any of them, but never by two at the same time, and
+ * the solutions come in the same order as with a single thread.
+ * Returns 0 on success, 1-based index of bad arg on failure, -1 if the
+ * search was stopped after finding max_solutions solutions.
+ */
+int nissy_solve_cb(
+	char *step,
+	char *trans,
+	int mindepth,
+	int maxdepth,
+	int optimal,
+	char *type,
+	char *scr,
+	void (*sink)(char *, void *),
+	void *data,
+	int threads,
+	int max_solutions
+);
+
+/*
+ * Counters of a search, see nissy_solve_stats(). They are only collected
+ * if nissy is compiled with STATS defined, otherwise they are all 0.
+ */
+#define NISSY_STATS_DEPTHS 23 /* Solutions have at most 22 moves */
+
+struct nissy_stats {
+	uint64_t nodes[NISSY_STATS_DEPTHS]; /* Nodes visited, by depth */
+	uint64_t pruned;        /* Nodes cut by the lower bound */
+	uint64_t shortened;     /* Solutions rejected as not minimal */
+	uint64_t nissed;        /* Switches to the inverse scramble */
+	uint64_t niss_rejected; /* Switches that did not make sense */
+	uint64_t fallbacks;     /* Lookups in the base pruning tables */
+};
+
+/*
+ * Same as nissy_solve_cb(), but the counters of the search are also
+ * written to stats, so that a slow search can be looked into.
+ */
+int nissy_solve_stats(
+	char *step,
+	char *trans,
+	int mindepth,
+	int maxdepth,
+	int optimal,
+	char *type,
+	char *scr,
+	void (*sink)(char *, void *),
+	void *data,
+	int threads,
+	int max_solutions,
+	struct nissy_stats *stats
+);
+
+/*
+ * Same as nissy_solve_range(), but at most size bytes are written to sol,
+ * including the terminator. If not all the solutions fit, only the first
+ * ones are written. In any case, the size needed for all of them is
+ * written to needed, so the call can be repeated with a large enough
+ * buffer.
+ * The return value is as for nissy_solve_cb().
+ */
+int nissy_solve_buf(
+	char *step,
+	char *trans,
+	int mindepth,
+	int maxdepth,
+	int optimal,
+	char *type,
+	char *scr,
+	char *sol,
+	size_t size,
+	size_t *needed,
+	int threads,
+	int max_solutions
+);
+
+/*
+ * Solves many scrambles with the same options, on up to threads threads.
+ * The solutions for scrs[i] are written to sols[i], a buffer of size
+ * bytes, as for nissy_solve_buf(), and the size needed for all of them is
+ * written to needed[i]. The result for each scramble is written to
+ * results[i]: 0 on success, -1 if the search was stopped after finding
+ * max_solutions solutions, 1 if the scramble is not valid.
+ * Returns 0 on success, 1-based index of bad arg on failure.
+ */
+int nissy_solve_batch(
+	char *step,
+	char *trans,
+	int mindepth,
+	int maxdepth,
+	int optimal,
+	char *type,
+	int n,           /* Number of scrambles */
+	char **scrs,
+	char **sols,
+	size_t size,
+	size_t *needed,
+	int *results,
+	int threads,
+	int max_solutions
+);
+
+/*
+ * Same as nissy_solve_cb(), but for many transformations at the same time:
+ * trans is a list of them separated by spaces or commas, for example
+ * "uf fr rd", or "all" for all 48 of them. The scramble is searched in
+ * each orientation concurrently, and sink receives the name of the
+ * transformation before each solution. The solutions are grouped by
+ * transformation, in the given order, and max_solutions applies to each
+ * transformation separately.
+ */
+int nissy_solve_multi(
+	char *step,
+	char *trans,
+	int mindepth,
+	int maxdepth,
+	int optimal,
+	char *type,
+	char *scr,
+	void (*sink)(char *trans, char *sol, void *data),
+	void *data,
+	int threads,
+	int max_solutions
 );
@@ -0,0 +1,191 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdbool.h>
+
+#include "pool.h"
+
+/*
+ * A small work-stealing pool for a fixed list of n tasks. Each worker
+ * starts with a contiguous range [lo, hi) of task indices. It takes tasks
+ * from the front of its own range and, when that is empty, steals from the
+ * back of the range of another worker. No task is added while the pool is
+ * running, so a worker can stop as soon as all ranges are empty.
+ */
+
+#ifndef _WIN32
+
+typedef struct {
+	pthread_mutex_t mutex;
+	int lo;
+	int hi;
+} Deque;
+
+typedef struct {
+	int id;
+	int nthreads;
+	Deque *deque;
+	PoolTask *f;
+	void *data;
+} Worker;
+
+static bool take(Deque *, int *);
+static bool steal(Deque *, int *);
+static bool next_task(Worker *, int *);
+static void *run_worker(void *);
+
+static bool
+take(Deque *q, int *i)
+{
+	bool r;
+
+	pthread_mutex_lock(&q->mutex);
+	if ((r = q->lo < q->hi))
+		*i = q->lo++;
+	pthread_mutex_unlock(&q->mutex);
+
+	return r;
+}
+
+static bool
+steal(Deque *q, int *i)
+{
+	bool r;
+
+	pthread_mutex_lock(&q->mutex);
+	if ((r = q->lo < q->hi))
+		*i = --q->hi;
+	pthread_mutex_unlock(&q->mutex);
+
+	return r;
+}
+
+static bool
+next_task(Worker *w, int *i)
+{
+	int j;
+
+	if (take(&w->deque[w->id], i))
+		return true;
+
+	for (j = 1; j < w->nthreads; j++)
+		if (steal(&w->deque[(w->id + j) % w->nthreads], i))
+			return true;
+
+	return false;
+}
+
+static void *
+run_worker(void *arg)
+{
+	int i;
+	Worker *w = (Worker *)arg;
+
+	while (next_task(w, &i))
+		w->f(w->data, i);
+
+	return NULL;
+}
+
+/*
+ * Calls f(data, i) once for each 0 <= i < n, using up to nthreads threads
+ * including the calling one. The order in which tasks run is unspecified.
+ */
+void
+run_pool(int nthreads, int n, PoolTask *f, void *data)
+{
+	int i;
+	bool started[MAX_THREADS];
+	pthread_t thread[MAX_THREADS];
+	Deque deque[MAX_THREADS];
+	Worker worker[MAX_THREADS];
+
+	nthreads = nthreads < 1 ? 1 : nthreads;
+	nthreads = nthreads > MAX_THREADS ? MAX_THREADS : nthreads;
+	nthreads = nthreads > n ? n : nthreads;
+	if (nthreads <= 1) {
+		for (i = 0; i < n; i++)
+			f(data, i);
+		return;
+	}
+
+	for (i = 0; i < nthreads; i++) {
+		pthread_mutex_init(&deque[i].mutex, NULL);
+		deque[i].lo = (int)((long long)n * i / nthreads);
+		deque[i].hi = (int)((long long)n * (i+1) / nthreads);
+		worker[i].id = i;
+		worker[i].nthreads = nthreads;
+		worker[i].deque = deque;
+		worker[i].f = f;
+		worker[i].data = data;
+	}
+
+	/* If a thread cannot be started, its tasks are stolen by the others */
+	for (i = 1; i < nthreads; i++)
+		started[i] = !pthread_create(
+		    &thread[i], NULL, run_worker, &worker[i]);
+	run_worker(&worker[0]);
+	for (i = 1; i < nthreads; i++)
+		if (started[i])
+			pthread_join(thread[i], NULL);
+
+	for (i = 0; i < nthreads; i++)
+		pthread_mutex_destroy(&deque[i].mutex);
+}
+
+void
+pool_lock_init(PoolLock *l)
+{
+	pthread_mutex_init(l, NULL);
+}
+
+void
+pool_lock_destroy(PoolLock *l)
+{
+	pthread_mutex_destroy(l);
+}
+
+void
+pool_lock(PoolLock *l)
+{
+	pthread_mutex_lock(l);
+}
+
+void
+pool_unlock(PoolLock *l)
+{
+	pthread_mutex_unlock(l);
+}
+
+#else
+/* No pthreads here, the tasks are run in order on the calling thread */
+void
+run_pool(int nthreads, int n, PoolTask *f, void *data)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+		f(data, i);
+}
+
+void
+pool_lock_init(PoolLock *l)
+{
+}
+
+void
+pool_lock_destroy(PoolLock *l)
+{
+}
+
+void
+pool_lock(PoolLock *l)
+{
+}
+
+void
+pool_unlock(PoolLock *l)
+{
+}
+#endif
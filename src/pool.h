@@ -0,0 +1,31 @@
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#define MAX_THREADS 64
+
+typedef void (PoolTask)(void *, int);
+
+/* A lock for the short critical sections of the tasks of one pool */
+#ifndef _WIN32
+typedef pthread_mutex_t PoolLock;
+#define POOL_LOCK_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#else
+typedef int PoolLock;
+#define POOL_LOCK_INITIALIZER 0
+#endif
+
+/* For values that a task reads while other tasks may change them */
+#ifndef _WIN32
+#define POOL_LOAD(p)     __atomic_load_n(p, __ATOMIC_RELAXED)
+#define POOL_STORE(p, v) __atomic_store_n(p, v, __ATOMIC_RELAXED)
+#else
+#define POOL_LOAD(p)     (*(p))
+#define POOL_STORE(p, v) (*(p) = (v))
+#endif
+
+void run_pool(int, int, PoolTask *, void *);
+void pool_lock_init(PoolLock *);
+void pool_lock_destroy(PoolLock *);
+void pool_lock(PoolLock *);
+void pool_unlock(PoolLock *);
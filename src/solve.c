@@ -1,26 +1,120 @@
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 
 #include "cube.h"
 #include "coord.h"
 #include "solve.h"
-
+#include "pool.h"
+
+/*
+ * A parallel search is split into tasks at depth SPLIT_DEPTH: each task is
+ * a call to dfs() that the sequential search would make at that depth, in
+ * the same order. The tasks write their solutions in separate buffers.
+ * When all the tasks before it are done, the solutions of a task are sent
+ * to the sink and its buffer is freed, so the sink receives them in the
+ * same order as in a sequential search, and never from two threads at
+ * the same time.
+ */
+#define SPLIT_DEPTH 2
+
+/*
+ * With a limit on the number of solutions, each task stops when it has
+ * found enough of them. Moreover, once the tasks before index stop are
+ * done and have found enough solutions, the tasks after it are cut short.
+ */
+
+/* Adds n to a counter of the SolveStats, only if STATS is defined */
+#ifdef STATS
+#define STAT_ADD(arg, field, n) ((arg)->stats->field += (n))
+#else
+#define STAT_ADD(arg, field, n)
+#endif
+
+/* Enough for a solution of MAX_ALG_LEN moves and its terminator */
+#define SOL_MAX_LEN (4*MAX_ALG_LEN + 4)
+
+typedef struct {
+	DfsArg arg;
+	Cube cube;
+	Cube inv;
+	Alg alg;
+	SolBuf buf;
+	int nsols;
+	bool done;
+	SolveStats stats;
+} DfsTask;
+
+struct tasklist {
+	int depth;
+	int n;
+	int size;
+	DfsTask *task;
+	bool error;
+	int max;
+	int stop;
+	int prefix;
+	int found;
+	SolSink *sink;
+	void *data;
+	SolveStats *stats;
+	PoolLock lock;
+	bool flushing;
+};
+
+static bool reserve_buf(SolBuf *, size_t);
 static void append_sol(DfsArg *);
 static bool allowed_next(Move m, Move l0, Move l1);
+static int ctz(uint32_t);
 static void get_state(Coordinate *[], Cube *, CubeState *);
 static int lower_bound(Coordinate *[], CubeState *);
+static int node_bound(DfsArg *);
 static bool trivialshorten(DfsArg *);
+static bool stopped(DfsArg *);
 static void dfs(DfsArg *);
 static void dfs_niss(DfsArg *);
-static void dfs_move(Move, DfsArg *);
+static void move_state(Coordinate *[], Move, CubeState *, CubeState *);
+static void set_dist(Coordinate *[], CubeState *, CubeState *);
 static bool niss_makes_sense(DfsArg *);
+static uint32_t nissable_moves(Step *);
+static void add_task(DfsArg *);
+static void run_task(void *, int);
+static void flush_task(TaskList *, DfsTask *);
+static bool solve_parallel(DfsArg *, int);
+static int fallbacks(Coordinate *[], CubeState *);
+static void add_stats(SolveStats *, SolveStats *);
+
+static bool
+reserve_buf(SolBuf *buf, size_t n)
+{
+	size_t size;
+	char *str;
+
+	if (buf->error)
+		return false;
+
+	if (buf->len + n <= buf->size)
+		return true;
+
+	size = MAX(2 * buf->size, buf->len + n);
+	if ((str = realloc(buf->str, size)) == NULL) {
+		buf->error = true;
+		return false;
+	}
+	buf->str = str;
+	buf->size = size;
+
+	return true;
+}
 
 static void
 append_sol(DfsArg *arg)
 {
 	Alg alg;
 	int i, n;
+	char str[SOL_MAX_LEN];
 
 	copy_alg(arg->current_alg, &alg);
 	transform_alg(inverse_trans(arg->t), &alg);
@@ -29,10 +123,18 @@ append_sol(DfsArg *arg)
 		for (i = 0; i < alg.len; i++)
 			alg.inv[i] = true;
 
-	n = alg_string(&alg, *arg->sol);
-	(*arg->sol)[n] = '\n';
-	(*arg->sol)[n+1] = 0;
-	*arg->sol += (n+1);
+	n = alg_string(&alg, str);
+
+	if (arg->buf != NULL) {
+		if (!reserve_buf(arg->buf, n+1))
+			return;
+		memcpy(arg->buf->str + arg->buf->len, str, n);
+		arg->buf->str[arg->buf->len + n] = '\n';
+		arg->buf->len += n+1;
+	} else {
+		arg->sink(str, arg->data);
+	}
+	(*arg->nsols)++;
 }
 
 static bool
@@ -48,13 +150,31 @@ allowed_next(Move m, Move l0, Move l1)
 	return allowed && order;
 }
 
+/* Index of the lowest set bit, x must not be 0 */
+static int
+ctz(uint32_t x)
+{
+#if defined(__GNUC__)
+	return __builtin_ctz(x);
+#else
+	int ret;
+
+	for (ret = 0; !(x & 1); x >>= 1)
+		ret++;
+
+	return ret;
+#endif
+}
+
 void
 get_state(Coordinate *coord[], Cube *cube, CubeState *state)
 {
 	int i;
 
-	for (i = 0; coord[i] != NULL; i++)
+	for (i = 0; coord[i] != NULL; i++) {
 		state[i].val = index_coord(coord[i], cube, &state[i].t);
+		state[i].dist = ptabledist(coord[i], state[i].val);
+	}
 }
 
 static int
@@ -64,63 +184,132 @@ lower_bound(Coordinate *coord[], CubeState *state)
 
 	ret = -1;
 	for (i = 0; coord[i] != NULL; i++)
-		ret = MAX(ret, ptableval(coord[i], state[i].val));
+		ret = MAX(ret, state[i].dist);
 
 	return ret;
 }
 
+/* The lower bound used to prune the search at the current node */
+static int
+node_bound(DfsArg *arg)
+{
+	int bound;
+
+	bound = lower_bound(arg->s->coord, arg->state);
+	if (arg->st == NISS && !arg->niss)
+		bound = MIN(1, bound);
+
+	return bound;
+}
+
 static bool
 trivialshorten(DfsArg *arg)
 {
-	int bound;
+	Move m;
+	CubeState state[MAX_N_COORD];
 
 	if (!commute(arg->last[0], arg->last[1]))
 		return false;
 
-	dfs_move(inverse_move(arg->last[1]), arg);
-	bound = lower_bound(arg->s->coord, arg->state);
-	dfs_move(arg->last[1], arg);
+	m = inverse_move(arg->last[1]);
+	move_state(arg->s->coord, m, arg->state, state);
+	set_dist(arg->s->coord, arg->state, state);
 
-	return bound == 0;
+	return lower_bound(arg->s->coord, state) == 0;
 }
 
+static bool
+stopped(DfsArg *arg)
+{
+	if (arg->max > 0 && *arg->nsols >= arg->max)
+		return true;
+
+	if (arg->buf != NULL && arg->buf->error)
+		return true;
+
+	return arg->stop != NULL && arg->index >= POOL_LOAD(arg->stop);
+}
+
+/*
+ * The children of a node are expanded in two passes: first the coordinates
+ * of all of them are computed and their pruning table entries are
+ * prefetched, then they are pruned and searched in order. This way the
+ * pruning table lookups of the siblings overlap, instead of waiting for
+ * each other when the tables do not fit in the cache.
+ */
 static void
 dfs(DfsArg *arg)
 {
-	Move m, last[2];
+	Move m, last[2], moves[NMOVES_HTM];
 	bool len, niss;
-	int bound;
+	int i, j, n, bound;
+	uint32_t next;
+	CubeState state[MAX_N_COORD], child[NMOVES_HTM][MAX_N_COORD];
+	Coordinate **coord = arg->s->coord;
+	Cube *inv, childinv;
 
-	bound = lower_bound(arg->s->coord, arg->state);
-	if (arg->st == NISS && !arg->niss)
-		bound = MIN(1, bound);
+	if (stopped(arg))
+		return;
 
-	if (bound + arg->current_alg->len > arg->d)
+	if (arg->tasks != NULL && arg->current_alg->len == arg->tasks->depth) {
+		add_task(arg);
 		return;
+	}
+
+	STAT_ADD(arg, nodes[arg->current_alg->len], 1);
+	bound = node_bound(arg);
+	if (bound + arg->current_alg->len > arg->d) {
+		STAT_ADD(arg, pruned, 1);
+		return;
+	}
 
 	if (bound == 0) {
 		len = arg->current_alg->len == arg->d;
 		niss = !(arg->st == NISS) || arg->has_nissed;
-		if (len && niss && !trivialshorten(arg))
+		if (len && niss && trivialshorten(arg))
+			STAT_ADD(arg, shortened, 1);
+		else if (len && niss)
 			append_sol(arg);
 		return;
 	}
 
 	last[0] = arg->last[0];
 	last[1] = arg->last[1];
+	n = 0;
+	for (next = arg->s->next[last[0]][last[1]]; next; next &= next-1) {
+		m = moves[n] = ctz(next);
+		move_state(coord, m, arg->state, child[n]);
+		for (j = 0; coord[j] != NULL; j++)
+			ptableprefetch(coord[j], child[n][j].val);
+		n++;
+	}
+
+	memcpy(state, arg->state, sizeof(state));
+	inv = arg->inv;
 	arg->last[1] = arg->last[0];
-	for (m = U; m <= B3; m++) {
-		if (!arg->s->moveset(m))
+	for (i = 0; i < n; i++) {
+		set_dist(coord, state, child[i]);
+		STAT_ADD(arg, fallbacks, fallbacks(coord, child[i]));
+		memcpy(arg->state, child[i], sizeof(state));
+		if (node_bound(arg) + arg->current_alg->len + 1 > arg->d) {
+			STAT_ADD(arg, nodes[arg->current_alg->len + 1], 1);
+			STAT_ADD(arg, pruned, 1);
 			continue;
-		if (allowed_next(m, last[0], last[1])) {
-			arg->last[0] = m;
-			append_move(arg->current_alg, m, arg->niss);
-			dfs_move(m, arg);
-			dfs(arg);
-			dfs_move(inverse_move(m), arg);
-			arg->current_alg->len--;
 		}
+		if (inv != NULL) {
+			/* The inverse of the moves is applied before them */
+			make_solved(&childinv);
+			apply_move(inverse_move(moves[i]), &childinv);
+			compose(inv, &childinv);
+			arg->inv = &childinv;
+		}
+		arg->last[0] = moves[i];
+		append_move(arg->current_alg, moves[i], arg->niss);
+		dfs(arg);
+		arg->current_alg->len--;
 	}
+	memcpy(arg->state, state, sizeof(state));
+	arg->inv = inv;
 	arg->last[0] = last[0];
 	arg->last[1] = last[1];
 
@@ -133,25 +322,28 @@ dfs_niss(DfsArg *arg)
 {
 	int i;
 	DfsArg newarg;
-	Cube c, newcube;
+	Cube newcube;
 
 	newarg.s           = arg->s;
 	newarg.t           = arg->t;
 	newarg.st          = arg->st;
 	newarg.d           = arg->d;
-	newarg.sol         = arg->sol;
+	newarg.sink        = arg->sink;
+	newarg.data        = arg->data;
 	newarg.current_alg = arg->current_alg;
-
-	/* Invert current alg and scramble */
+	newarg.buf         = arg->buf;
+	newarg.tasks       = arg->tasks;
+	newarg.max         = arg->max;
+	newarg.nsols       = arg->nsols;
+	newarg.index       = arg->index;
+	newarg.stop        = arg->stop;
+	newarg.nissable    = arg->nissable;
+	newarg.stats       = arg->stats;
+
+	/* The inverse of the scramble followed by the current alg */
+	copy_cube(arg->inv, &newcube);
 	newarg.cube = &newcube;
-
-	make_solved(newarg.cube);
-	apply_alg(arg->current_alg, newarg.cube);
-	invert_cube(newarg.cube);
-
-	copy_cube(arg->cube, &c);
-	invert_cube(&c);
-	compose(&c, newarg.cube);
+	newarg.inv = NULL;
 
 	/* New indexes */
 	get_state(newarg.s->coord, newarg.cube, newarg.state);
@@ -165,54 +357,311 @@ dfs_niss(DfsArg *arg)
 	newarg.niss = true;
 	newarg.has_nissed = true;
 
+	STAT_ADD(arg, nissed, 1);
 	dfs(&newarg);
 }
 
+/*
+ * Writes in to the coordinates obtained by applying m to from, without
+ * the distances: those are set by set_dist(), so that the pruning table
+ * lookups can be delayed.
+ */
 static void
-dfs_move(Move m, DfsArg *arg)
+move_state(Coordinate *coord[], Move m, CubeState *from, CubeState *to)
 {
 	int i;
 	Move mm;
 	Trans tt = uf; /* Avoid uninitialized warning */
 
-	for (i = 0; arg->s->coord[i] != NULL; i++) {
-		mm = transform_move(arg->state[i].t, m);
-		arg->state[i].val = move_coord(
-		    arg->s->coord[i], mm, arg->state[i].val, &tt);
-		arg->state[i].t = transform_trans(tt, arg->state[i].t);
+	for (i = 0; coord[i] != NULL; i++) {
+		mm = transform_move(from[i].t, m);
+		to[i].val = move_coord(coord[i], mm, from[i].val, &tt);
+		to[i].t = transform_trans(tt, from[i].t);
 	}
 }
 
+/* Sets the distances of to, a state next to from */
+static void
+set_dist(Coordinate *coord[], CubeState *from, CubeState *to)
+{
+	int i;
+
+	for (i = 0; coord[i] != NULL; i++)
+		to[i].dist = ptableneighbor(coord[i], to[i].val, from[i].dist);
+}
+
 static bool
 niss_makes_sense(DfsArg *arg)
 {
-	Cube testcube;
-	CubeState state[MAX_N_COORD];
 	bool b1, b2, comm;
 
 	if (arg->niss || !(arg->st == NISS) || arg->current_alg->len == 0)
 		return false;
 
-	make_solved(&testcube);
-	apply_move(inverse_move(arg->last[0]), &testcube);
-	get_state(arg->s->coord, &testcube, state);
-	b1 = lower_bound(arg->s->coord, state) > 0;
+	b1 = (arg->nissable >> arg->last[0]) & 1;
+	b2 = (arg->nissable >> arg->last[1]) & 1;
+	comm = commute(arg->last[0], arg->last[1]);
+
+	if (!b1 || (comm && !b2)) {
+		STAT_ADD(arg, niss_rejected, 1);
+		return false;
+	}
+
+	return true;
+}
 
-	make_solved(&testcube);
-	apply_move(inverse_move(arg->last[1]), &testcube);
-	get_state(arg->s->coord, &testcube, state);
-	b2 = lower_bound(arg->s->coord, state) > 0;
+/*
+ * Bit m of the result is set if the inverse of m, applied to a solved cube,
+ * leaves the step unsolved. NULLMOVE never is.
+ */
+static uint32_t
+nissable_moves(Step *s)
+{
+	Move m;
+	uint32_t ret;
+	Cube c;
+	CubeState state[MAX_N_COORD];
 
-	comm = commute(arg->last[0], arg->last[1]);
+	ret = 0;
+	for (m = U; m <= B3; m++) {
+		make_solved(&c);
+		apply_move(inverse_move(m), &c);
+		get_state(s->coord, &c, state);
+		if (lower_bound(s->coord, state) > 0)
+			ret |= (uint32_t)1 << m;
+	}
+
+	return ret;
+}
+
+static void
+add_task(DfsArg *arg)
+{
+	int size;
+	DfsTask *task;
+	TaskList *tl = arg->tasks;
+
+	if (tl->error)
+		return;
+
+	if (tl->n == tl->size) {
+		size = MAX(2 * tl->size, 64);
+		if ((task = realloc(tl->task, size * sizeof(DfsTask))) == NULL) {
+			tl->error = true;
+			return;
+		}
+		tl->task = task;
+		tl->size = size;
+	}
+
+	/* Pointers are set when the task is run, the list may move */
+	task = &tl->task[tl->n++];
+	task->arg = *arg;
+	copy_cube(arg->cube, &task->cube);
+	if (arg->inv != NULL)
+		copy_cube(arg->inv, &task->inv);
+	copy_alg(arg->current_alg, &task->alg);
+	task->buf.str = NULL;
+	task->buf.len = 0;
+	task->buf.size = 0;
+	task->buf.error = false;
+	task->nsols = 0;
+	task->done = false;
+	memset(&task->stats, 0, sizeof(SolveStats));
+}
+
+static void
+run_task(void *data, int i)
+{
+	TaskList *tl = (TaskList *)data;
+	DfsTask *task = &tl->task[i];
+
+	task->arg.cube = &task->cube;
+	if (task->arg.inv != NULL)
+		task->arg.inv = &task->inv;
+	task->arg.current_alg = &task->alg;
+	task->arg.buf = &task->buf;
+	task->arg.tasks = NULL;
+	task->arg.max = tl->max;
+	task->arg.nsols = &task->nsols;
+	task->arg.index = i;
+	task->arg.stop = &tl->stop;
+	task->arg.stats = &task->stats;
+
+	dfs(&task->arg);
+
+	pool_lock(&tl->lock);
+	add_stats(tl->stats, &task->stats);
+	task->done = true;
+	if (tl->flushing) {
+		/* The thread that is flushing will get to this task */
+		pool_unlock(&tl->lock);
+		return;
+	}
+	tl->flushing = true;
+	while (tl->prefix < tl->stop && tl->task[tl->prefix].done) {
+		pool_unlock(&tl->lock);
+		flush_task(tl, &tl->task[tl->prefix]);
+		pool_lock(&tl->lock);
+		tl->prefix++;
+		if (tl->max > 0 && tl->found >= tl->max)
+			POOL_STORE(&tl->stop, tl->prefix);
+	}
+	tl->flushing = false;
+	pool_unlock(&tl->lock);
+}
 
-	return b1 > 0 && !(comm && b2 == 0);
+/*
+ * Called by one thread at a time, in task order, without holding the lock:
+ * the sink and the search below can take long, and the sink may even
+ * start a new search.
+ */
+static void
+flush_task(TaskList *tl, DfsTask *task)
+{
+	int i;
+	char *str, *end;
+	SolveStats discard;
+
+	if (task->buf.error) {
+		/* Out of memory, search again sending solutions directly */
+		task->nsols = 0;
+		task->arg.buf = NULL;
+		task->arg.stop = NULL;
+		task->arg.max = tl->max > 0 ? tl->max - tl->found : 0;
+		/* The nodes of the task have been counted already */
+		task->arg.stats = &discard;
+		dfs(&task->arg);
+		tl->found += task->nsols;
+	} else {
+		str = task->buf.str;
+		for (i = 0; i < task->nsols; i++) {
+			if (tl->max > 0 && tl->found >= tl->max)
+				break;
+			end = memchr(str, '\n',
+			    task->buf.len - (str - task->buf.str));
+			*end = 0;
+			tl->sink(str, tl->data);
+			str = end + 1;
+			tl->found++;
+		}
+	}
+
+	free(task->buf.str);
+	task->buf.str = NULL;
 }
 
+/*
+ * Returns false if the search could not be split into tasks, in which case
+ * nothing is sent to the sink.
+ */
+static bool
+solve_parallel(DfsArg *arg, int threads)
+{
+	int i;
+	TaskList tl;
+
+	tl.depth  = MIN(SPLIT_DEPTH, arg->d);
+	tl.n      = 0;
+	tl.size   = 0;
+	tl.task   = NULL;
+	tl.error  = false;
+	tl.max    = arg->max > 0 ? arg->max - *arg->nsols : 0;
+	tl.prefix = 0;
+	tl.found  = 0;
+	tl.sink   = arg->sink;
+	tl.data   = arg->data;
+	tl.stats  = arg->stats;
+	tl.flushing = false;
+
+	arg->tasks = &tl;
+	dfs(arg);
+	arg->tasks = NULL;
+
+	if (tl.error) {
+		free(tl.task);
+		return false;
+	}
+
+	tl.stop = tl.n;
+	pool_lock_init(&tl.lock);
+	run_pool(threads, tl.n, run_task, &tl);
+	pool_lock_destroy(&tl.lock);
+
+	for (i = 0; i < tl.n; i++)
+		free(tl.task[i].buf.str);
+	free(tl.task);
+	*arg->nsols += tl.found;
+
+	return true;
+}
+
+/* The number of states whose distance is looked up in the base tables */
+static int
+fallbacks(Coordinate *coord[], CubeState *state)
+{
+	int i, n;
+
+	for (i = 0, n = 0; coord[i] != NULL; i++)
+		n += ptablefallback(coord[i], state[i].val);
+
+	return n;
+}
+
+static void
+add_stats(SolveStats *to, SolveStats *from)
+{
+#ifdef STATS
+	int i;
+
+	for (i = 0; i <= MAX_ALG_LEN; i++)
+		to->nodes[i] += from->nodes[i];
+	to->pruned        += from->pruned;
+	to->shortened     += from->shortened;
+	to->nissed        += from->nissed;
+	to->niss_rejected += from->niss_rejected;
+	to->fallbacks     += from->fallbacks;
+#endif
+}
+
+/*
+ * Must be called on each step before solving it, and not while it is
+ * being solved.
+ */
+void
+init_step(Step *s)
+{
+	Move l0, l1, m;
+
+	for (l0 = NULLMOVE; l0 <= B3; l0++) {
+		for (l1 = NULLMOVE; l1 <= B3; l1++) {
+			s->next[l0][l1] = 0;
+			for (m = U; m <= B3; m++)
+				if (s->moveset(m) && allowed_next(m, l0, l1))
+					s->next[l0][l1] |= (uint32_t)1 << m;
+		}
+	}
+}
+
+/*
+ * Solutions are sent to opts->sink as soon as they are found, together
+ * with opts->data. They are searched for with length from opts->mindepth
+ * to opts->maxdepth, in this order, starting from the same root state.
+ * If opts->optimal is not negative, the search stops opts->optimal moves
+ * after the first length that has a solution. A non-positive opts->max
+ * means no limit on the number of solutions. If opts->stats is not NULL,
+ * the counters of the search are written there.
+ * Returns 1 if the search was stopped because opts->max solutions were
+ * found, 0 otherwise.
+ */
 int
-solve(Step *s, Trans t, int d, SolutionType st, Cube *c, char *sol)
+solve(Step *s, Trans t, SolutionType st, Cube *c, SolveOptions *opts)
 {
+	int d, maxdepth, nsols;
 	Alg alg;
 	DfsArg arg;
+	Cube inv;
+	SolveStats stats;
 
 	arg.niss        = false;
 	arg.has_nissed  = false;
@@ -229,14 +678,46 @@ solve(Step *s, Trans t, int d, SolutionType st, Cube *c, char *sol)
 	arg.t = t;
 	arg.st = st;
 
-	arg.d = d;
-	arg.sol = &sol;
+	arg.sink = opts->sink;
+	arg.data = opts->data;
+	arg.buf = NULL;
+	arg.tasks = NULL;
+
+	nsols = 0;
+	arg.max = opts->max;
+	arg.nsols = &nsols;
+	arg.index = 0;
+	arg.stop = NULL;
+
+	arg.stats = opts->stats != NULL ? opts->stats : &stats;
+	memset(arg.stats, 0, sizeof(SolveStats));
 
 	if (arg.st == INVERSE)
 		invert_cube(c);
 	apply_trans(arg.t, c);
 	get_state(arg.s->coord, arg.cube, arg.state);
 
-	dfs(&arg);
-	return 0;
+	/* For NISS, keep track of the inverse of the current position */
+	arg.inv = NULL;
+	arg.nissable = 0;
+	if (arg.st == NISS) {
+		copy_cube(c, &inv);
+		invert_cube(&inv);
+		arg.inv = &inv;
+		arg.nissable = nissable_moves(s);
+	}
+
+	maxdepth = MIN(opts->maxdepth, MAX_ALG_LEN);
+	for (d = opts->mindepth; d <= maxdepth && !stopped(&arg); d++) {
+		arg.d = d;
+
+		/* If the parallel search fails, fall back to a sequential one */
+		if (opts->threads <= 1 || !solve_parallel(&arg, opts->threads))
+			dfs(&arg);
+
+		if (opts->optimal >= 0 && nsols > 0)
+			maxdepth = MIN(maxdepth, d + opts->optimal);
+	}
+
+	return stopped(&arg);
 }
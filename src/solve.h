@@ -1,25 +1,63 @@
 #define MAX_N_COORD 3
 
 typedef enum { NORMAL, INVERSE, NISS } SolutionType;
-typedef struct { coord_value_t val; Trans t; } CubeState;
+typedef struct { coord_value_t val; Trans t; int dist; } CubeState;
+typedef struct { char *str; size_t len; size_t size; bool error; } SolBuf;
+typedef struct tasklist TaskList;
+typedef void (SolSink)(char *, void *);
+/*
+ * Counters of a search. They are only updated if nissy is compiled with
+ * STATS defined, otherwise they are left at 0 and cost nothing.
+ */
+typedef struct {
+	uint64_t nodes[MAX_ALG_LEN+1]; /* Nodes visited, by depth */
+	uint64_t pruned;               /* Nodes cut by the lower bound */
+	uint64_t shortened;            /* Solutions rejected as not minimal */
+	uint64_t nissed;               /* Switches to the inverse scramble */
+	uint64_t niss_rejected;        /* Switches that did not make sense */
+	uint64_t fallbacks;            /* Lookups in the base pruning tables */
+} SolveStats;
+typedef struct {
+	int mindepth;
+	int maxdepth;
+	int optimal;
+	int max;
+	int threads;
+	SolSink *sink;
+	void *data;
+	SolveStats *stats;
+} SolveOptions;
 typedef struct {
 	char *shortname;
 	Moveset *moveset;
 	Coordinate *coord[MAX_N_COORD];
+	/* Bit m of next[l0][l1] is set if m can follow the moves l1 l0 */
+	uint32_t next[NMOVES_HTM][NMOVES_HTM];
 } Step;
 typedef struct {
 	Cube *cube;
+	Cube *inv;
+	uint32_t nissable;
 	CubeState state[MAX_N_COORD];
 	Step *s;
 	Trans t;
 	SolutionType st;
-	char **sol;
+	SolSink *sink;
+	void *data;
 	int d;
 	bool niss;
 	bool has_nissed;
 	Move last[2];
 	Move lastinv[2];
 	Alg *current_alg;
+	SolBuf *buf;
+	TaskList *tasks;
+	int max;
+	int *nsols;
+	int index;
+	int *stop;
+	SolveStats *stats;
 } DfsArg;
 
-int solve(Step *, Trans, int, SolutionType, Cube *, char *);
+void init_step(Step *);
+int solve(Step *, Trans, SolutionType, Cube *, SolveOptions *);
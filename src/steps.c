@@ -18,6 +18,8 @@ static bool moveset_eofb(Move);
 static bool moveset_drud(Move);
 static bool moveset_htr(Move);
 
+static int popcount(unsigned);
+static int ctz(unsigned);
 static int factorial(int);
 static int perm_to_index(int *, int);
 static void index_to_perm(int, int, int *);
@@ -29,6 +31,28 @@ static void int_to_digit_array(int, int, int, int *);
 static void int_to_sum_zero_array(int, int, int, int *);
 static int perm_sign(int *, int);
 
+/* Only valid for arguments up to 12, the size of the largest set of pieces */
+static const int factorial_table[13] = {
+	1, 1, 2, 6, 24, 120, 720,
+	5040, 40320, 362880, 3628800, 39916800, 479001600
+};
+
+static const int binomial_table[13][13] = {
+	{ 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	{ 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	{ 1, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	{ 1, 3, 3, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	{ 1, 4, 6, 4, 1, 0, 0, 0, 0, 0, 0, 0, 0 },
+	{ 1, 5, 10, 10, 5, 1, 0, 0, 0, 0, 0, 0, 0 },
+	{ 1, 6, 15, 20, 15, 6, 1, 0, 0, 0, 0, 0, 0 },
+	{ 1, 7, 21, 35, 35, 21, 7, 1, 0, 0, 0, 0, 0 },
+	{ 1, 8, 28, 56, 70, 56, 28, 8, 1, 0, 0, 0, 0 },
+	{ 1, 9, 36, 84, 126, 126, 84, 36, 9, 1, 0, 0, 0 },
+	{ 1, 10, 45, 120, 210, 252, 210, 120, 45, 10, 1, 0, 0 },
+	{ 1, 11, 55, 165, 330, 462, 462, 330, 165, 55, 11, 1, 0 },
+	{ 1, 12, 66, 220, 495, 792, 924, 792, 495, 220, 66, 12, 1 },
+};
+
 static coord_value_t index_eofb(Cube *cube);
 static void     invindex_eofb(coord_value_t ind, Cube *ret);
 Indexer i_eofb = {
@@ -117,7 +141,7 @@ Coordinate coord_epe = {
 	.name = "epe",
 	.type = COMP_COORD,
 	.i    = {&i_epe, NULL},
-	.moveset = moveset_HTM,
+	.moveset = moveset_drud,
 };
 
 Coordinate coord_eposepe = {
@@ -147,6 +171,7 @@ Coordinate coord_eofbepos_sym16 = {
 	.base = {&coord_eofbepos, NULL},
 	.tgrp = &tgrp_udfix,
 	.moveset = moveset_HTM,
+	.indexmajor = true,
 };
 
 Coordinate coord_cp_sym16 = {
@@ -155,6 +180,7 @@ Coordinate coord_cp_sym16 = {
 	.base = {&coord_cp, NULL},
 	.tgrp = &tgrp_udfix,
 	.moveset = moveset_HTM,
+	.indexmajor = true,
 };
 
 Coordinate coord_drud_sym16 = {
@@ -162,6 +188,7 @@ Coordinate coord_drud_sym16 = {
 	.type = SYMCOMP_COORD,
 	.base = {&coord_eofbepos_sym16, &coord_coud},
 	.moveset = moveset_HTM,
+	.mod3 = true,
 };
 
 Coordinate coord_drudfin_noE_sym16 = {
@@ -169,6 +196,7 @@ Coordinate coord_drudfin_noE_sym16 = {
 	.type = SYMCOMP_COORD,
 	.base = {&coord_cp_sym16, &coord_epud},
 	.moveset = moveset_drud,
+	.mod3 = true,
 };
 
 Coordinate *coordinates[] = {
@@ -237,29 +265,74 @@ moveset_htr(Move m)
 }
 
 static int
-factorial(int n)
+popcount(unsigned x)
 {
-	int i, ret = 1;
+#if defined(__POPCNT__)
+	return __builtin_popcount(x);
+#else
+	/* Only the low 16 bits are ever set */
+	x = x - ((x >> 1) & 0x5555);
+	x = (x & 0x3333) + ((x >> 2) & 0x3333);
+	x = (x + (x >> 4)) & 0x0F0F;
+
+	return (x + (x >> 8)) & 0x1F;
+#endif
+}
 
-	if (n < 0)
-		return 0;
+/* Index of the lowest set bit, x must not be 0 */
+static int
+ctz(unsigned x)
+{
+#if defined(__GNUC__)
+	return __builtin_ctz(x);
+#else
+	int ret;
 
-	for (i = 1; i <= n; i++)
-		ret *= i;
+	for (ret = 0; !(x & 1); x >>= 1)
+		ret++;
 
 	return ret;
+#endif
 }
 
+static int
+factorial(int n)
+{
+	if (n < 0 || n > 12)
+		return 0;
+
+	return factorial_table[n];
+}
+
+/*
+ * Lehmer code: the digit of a[i] is the number of elements after it that
+ * are smaller, that is a[i] minus the number of smaller elements that
+ * have already been seen. The move and transformation tables also index
+ * cubes whose pieces are out of place for the coordinate (for example an
+ * R move on epe), for those we count the inversions one by one.
+ */
 static int
 perm_to_index(int *a, int n)
 {
 	int i, j, c, ret = 0;
+	unsigned seen = 0, bad = 0;
+
+	for (i = 0; i < n; i++)
+		bad |= (unsigned)a[i] >= (unsigned)n;
+
+	if (bad) {
+		for (i = 0; i < n; i++) {
+			for (c = 0, j = i+1; j < n; j++)
+				c += a[i] > a[j];
+			ret += factorial_table[n-i-1] * c;
+		}
+		return ret;
+	}
 
 	for (i = 0; i < n; i++) {
-		c = 0;
-		for (j = i+1; j < n; j++)
-			c += (a[i] > a[j]) ? 1 : 0;
-		ret += factorial(n-i-1) * c;
+		ret += factorial_table[n-i-1] *
+		    (a[i] - popcount(seen & ((1U << a[i]) - 1)));
+		seen |= 1U << a[i];
 	}
 
 	return ret;
@@ -268,34 +341,34 @@ perm_to_index(int *a, int n)
 static void
 index_to_perm(int p, int n, int *r)
 {
-	int a[n];
 	int i, j, c;
+	unsigned left, m;
 
-	for (i = 0; i < n; i++)
-		a[i] = 0;
-
-	if (p < 0 || p >= factorial(n))
+	if (p < 0 || p >= factorial(n)) {
 		for (i = 0; i < n; i++)
 			r[i] = -1;
+		return;
+	}
 
+	/* The element with digit c is the (c+1)-th smallest one left */
+	left = (1U << n) - 1;
 	for (i = 0; i < n; i++) {
-		c = 0;
-		j = 0;
-		while (c <= p / factorial(n-i-1))
-			c += a[j++] ? 0 : 1;
-		r[i] = j-1;
-		a[j-1] = 1;
-		p %= factorial(n-i-1);
+		c = p / factorial_table[n-i-1];
+		p %= factorial_table[n-i-1];
+		for (m = left, j = 0; j < c; j++)
+			m &= m-1;
+		r[i] = ctz(m);
+		left &= ~(1U << r[i]);
 	}
 }
 
 static int
 binomial(int n, int k)
 {
-	if (n < 0 || k < 0 || k > n)
+	if (n < 0 || n > 12 || k < 0 || k > n)
 		return 0;
 
-	return factorial(n) / (factorial(k) * factorial(n-k));
+	return binomial_table[n][k];
 }
 
 static int 
@@ -303,13 +376,15 @@ subset_to_index(int *a, int n, int k)
 {
 	int i, ret = 0;
 
-	for (i = 0; i < n; i++) {
-		if (k == n-i)
-			return ret;
-		if (a[i]) {
-			ret += binomial(n-i-1, k);
-			k--;
-		}
+	/*
+	 * Once the remaining positions must all be taken,
+	 * binomial_table[n-i-1][k] is 0 and the rest adds nothing. The loop
+	 * stops when k reaches 0, so that an array with more than k elements
+	 * set cannot make it negative.
+	 */
+	for (i = 0; i < n && k > 0; i++) {
+		ret += a[i] * binomial_table[n-i-1][k];
+		k -= a[i];
 	}
 
 	return ret;
@@ -390,19 +465,34 @@ perm_sign(int *a, int n)
 static coord_value_t
 index_eofb(Cube *cube)
 {
-	return (coord_value_t)digit_array_to_int(cube->eo, 11, 2);
+	int i, eo[11];
+
+	for (i = 0; i < 11; i++)
+		eo[i] = EO(cube, i);
+
+	return (coord_value_t)digit_array_to_int(eo, 11, 2);
 }
 
 static coord_value_t
 index_coud(Cube *cube)
 {
-	return (coord_value_t)digit_array_to_int(cube->co, 7, 3);
+	int i, co[7];
+
+	for (i = 0; i < 7; i++)
+		co[i] = CO(cube, i);
+
+	return (coord_value_t)digit_array_to_int(co, 7, 3);
 }
 
 static coord_value_t
 index_cp(Cube *cube)
 {
-	return (coord_value_t)perm_to_index(cube->cp, 8);
+	int i, cp[8];
+
+	for (i = 0; i < 8; i++)
+		cp[i] = CP(cube, i);
+
+	return (coord_value_t)perm_to_index(cp, 8);
 }
 
 static coord_value_t
@@ -411,7 +501,7 @@ index_epe(Cube *cube)
 	int i, e[4];
 
 	for (i = 0; i < 4; i++)
-		e[i] = cube->ep[i+8] - 8;
+		e[i] = EP(cube, i+8) - 8;
 
 	return (coord_value_t)perm_to_index(e, 4);
 }
@@ -419,7 +509,12 @@ index_epe(Cube *cube)
 static coord_value_t
 index_epud(Cube *cube)
 {
-	return (coord_value_t)perm_to_index(cube->ep, 8);
+	int i, ep[8];
+
+	for (i = 0; i < 8; i++)
+		ep[i] = EP(cube, i);
+
+	return (coord_value_t)perm_to_index(ep, 8);
 }
 
 static coord_value_t
@@ -428,7 +523,7 @@ index_epos(Cube *cube)
 	int i, a[12];
 
 	for (i = 0; i < 12; i++)
-		a[i] = (cube->ep[i] < 8) ? 0 : 1;
+		a[i] = (EP(cube, i) < 8) ? 0 : 1;
 
 	return (coord_value_t)subset_to_index(a, 12, 4);
 }
@@ -441,8 +536,8 @@ index_eposepe(Cube *cube)
 
 	epos = (coord_value_t)index_epos(cube);
 	for (i = 0, j = 0; i < 12; i++)
-		if (cube->ep[i] >= 8)
-			e[j++] = cube->ep[i] - 8;
+		if (EP(cube, i) >= 8)
+			e[j++] = EP(cube, i) - 8;
 	epe = (coord_value_t)perm_to_index(e, 4);
 
 	return epos * FACTORIAL4 + epe;
@@ -451,65 +546,81 @@ index_eposepe(Cube *cube)
 static void
 invindex_eofb(coord_value_t ind, Cube *cube)
 {
-	int_to_sum_zero_array(ind, 2, 12, cube->eo);
+	int i, eo[12];
+
+	int_to_sum_zero_array(ind, 2, 12, eo);
+	for (i = 0; i < 12; i++)
+		SET_EO(cube, i, eo[i]);
 }
 
 static void
 invindex_coud(coord_value_t ind, Cube *cube)
 {
-	int_to_sum_zero_array(ind, 3, 8, cube->co);
+	int i, co[8];
+
+	int_to_sum_zero_array(ind, 3, 8, co);
+	for (i = 0; i < 8; i++)
+		SET_CO(cube, i, co[i]);
 }
 
 static void
 invindex_cp(coord_value_t ind, Cube *cube)
 {
-	index_to_perm(ind, 8, cube->cp);
+	int i, cp[8];
+
+	index_to_perm(ind, 8, cp);
+	for (i = 0; i < 8; i++)
+		SET_CP(cube, i, cp[i]);
 }
 
 static void
 invindex_epe(coord_value_t ind, Cube *cube)
 {
-	int i;
+	int i, e[4];
 
-	index_to_perm(ind, 4, &cube->ep[8]);
+	index_to_perm(ind, 4, e);
 	for (i = 0; i < 4; i++)
-		cube->ep[i+8] += 8;
+		SET_EP(cube, i+8, e[i] + 8);
 }
 
 static void
 invindex_epud(coord_value_t ind, Cube *cube)
 {
-	index_to_perm(ind, 8, cube->ep);
+	int i, ep[8];
+
+	index_to_perm(ind, 8, ep);
+	for (i = 0; i < 8; i++)
+		SET_EP(cube, i, ep[i]);
 }
 
 static void
 invindex_epos(coord_value_t ind, Cube *cube)
 {
-	int i, j, k;
+	int i, j, k, a[12];
 
-	index_to_subset(ind, 12, 4, cube->ep);
+	index_to_subset(ind, 12, 4, a);
 	for (i = 0, j = 0, k = 8; i < 12; i++)
-		if (cube->ep[i] == 0)
-			cube->ep[i] = j++;
+		if (a[i] == 0)
+			SET_EP(cube, i, j++);
 		else
-			cube->ep[i] = k++;
+			SET_EP(cube, i, k++);
 }
 
 static void
 invindex_eposepe(coord_value_t ind, Cube *cube)
 {
-	int i, j, k, e[4];
+	int i, j, k, a[12], e[4];
 	coord_value_t epos, epe;
 
 	epos = ind / FACTORIAL4;
 	epe = ind % FACTORIAL4;
 
-	index_to_subset(epos, 12, 4, cube->ep);
+	index_to_subset(epos, 12, 4, a);
 	index_to_perm(epe, 4, e);
 
 	for (i = 0, j = 0, k = 0; i < 12; i++)
-		if (cube->ep[i] == 0)
-			cube->ep[i] = j++;
+		if (a[i] == 0)
+			SET_EP(cube, i, j++);
 		else
-			cube->ep[i] = e[k++] + 8;
+			SET_EP(cube, i, e[k++] + 8);
 }